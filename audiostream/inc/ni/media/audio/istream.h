@@ -19,13 +19,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 //
-
 #pragma once
 
 #include <ni/media/audio/istream_info.h>
 #include <ni/media/audio/streambuf.h>
 
+#include <ni/media/pcm/algorithm/convert.h>
 #include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/detail/contiguous.h>
 #include <ni/media/pcm/iterator.h>
 
 #include <boost/range/has_range_iterator.hpp>
@@ -41,6 +42,9 @@
 namespace audio
 {
 
+template <class Value, class Format>
+class typed_istream;
+
 class istream : protected std::istream
 {
 public:
@@ -74,6 +78,11 @@ public:
     template <class Range>
     auto operator>>( Range&& rng ) -> std::enable_if_t<boost::has_range_iterator<Range>::value, istream&>;
 
+    // a view reading Value from a stream known to be in the compiletime format Format,
+    // throws std::runtime_error if the stream has a different format. Defined in typed_istream.h.
+    template <class Value, class Format>
+    auto as( Format fmt = {} ) -> typed_istream<Value, Format>;
+
     auto seekg( pos_type pos ) -> istream&;
     auto sample_seekg( pos_type pos ) -> istream&;
     auto frame_seekg( pos_type pos ) -> istream&;
@@ -103,6 +112,27 @@ protected:
     istream& operator=( istream&& );
 
 private:
+    template <class, class>
+    friend class typed_istream;
+
+    template <class Value, class Format>
+    void read_sample( Value& val, const Format& fmt );
+
+    template <class Value, class Iterator, class Format>
+    void read_samples( Iterator beg, Iterator end, const Format& fmt );
+
+    template <class Value, class Format>
+    auto get_area_kernel( const Format& fmt, std::true_type ) const -> pcm::read_kernel_t<Value>;
+
+    template <class Value, class Format>
+    auto get_area_kernel( const Format& fmt, std::false_type ) const -> std::false_type;
+
+    template <class Value, class Iterator, class Format>
+    auto copy_get_area( Iterator beg, Iterator end, const Format& fmt, pcm::read_kernel_t<Value> kernel ) -> Iterator;
+
+    template <class Value, class Iterator, class Format>
+    auto copy_get_area( Iterator beg, Iterator end, const Format& fmt, std::false_type ) -> Iterator;
+
     std::unique_ptr<streambuf> m_streambuf;
     std::unique_ptr<info_type> m_info;
 };
@@ -112,9 +142,7 @@ private:
 template <class Value>
 auto istream::operator>>( Value& val ) -> std::enable_if_t<std::is_arithmetic<Value>::value, istream&>
 {
-    std::array<char, 8> temp;
-    if ( read( temp.data(), m_info->bytes_per_sample() ) )
-        val = pcm::read<Value>( temp.data(), m_info->format() );
+    read_sample( val, m_info->format() );
     return *this;
 }
 
@@ -125,31 +153,45 @@ auto istream::operator>>( Range&& rng ) -> std::enable_if_t<boost::has_range_ite
 {
     using Value = typename boost::range_value<Range>::type;
 
-    const auto out_beg = std::begin( rng );
-    const auto out_end = std::end( rng );
+    read_samples<Value>( std::begin( rng ), std::end( rng ), m_info->format() );
+    return *this;
+}
 
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+void istream::read_sample( Value& val, const Format& fmt )
+{
+    std::array<char, 8> temp;
+    if ( read( temp.data(), m_info->bytes_per_sample() ) )
+        val = pcm::read<Value>( temp.data(), fmt );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Iterator, class Format>
+void istream::read_samples( Iterator out_beg, Iterator out_end, const Format& fmt )
+{
     if ( fail() || out_beg == out_end )
-        return *this;
+        return;
 
     if ( m_streambuf->underflow() == streambuf::traits_type::eof() )
     {
         setstate( rdstate() | eofbit | failbit );
-        return *this;
+        return;
     }
 
+    using IsContiguous = pcm::detail::is_contiguous_value_iterator<Iterator, Value>;
+
+    // contiguous output is converted block-wise, the format is resolved once for all refills
+    const auto kernel = get_area_kernel<Value>( fmt, IsContiguous{} );
+
     auto out_iter = out_beg;
     do
     {
         assert( std::distance( m_streambuf->gptr(), m_streambuf->egptr() ) % m_info->bytes_per_sample() == 0 );
 
-        auto pcm_beg = pcm::make_iterator<Value>( m_streambuf->gptr(), m_info->format() );
-        auto pcm_end = pcm::make_iterator<Value>( m_streambuf->egptr(), m_info->format() );
-
-        auto result = pcm::copy( pcm_beg, pcm_end, out_iter, out_end );
-        out_iter    = result.second;
-
-        auto count = static_cast<int>( std::distance( pcm_beg, result.first ) * m_info->bytes_per_sample() );
-        m_streambuf->gbump( count );
+        out_iter = copy_get_area<Value>( out_iter, out_end, fmt, kernel );
 
     } while ( out_iter != out_end && m_streambuf->underflow() != streambuf::traits_type::eof() );
 
@@ -158,8 +200,53 @@ auto istream::operator>>( Range&& rng ) -> std::enable_if_t<boost::has_range_ite
         std::fill( out_iter, out_end, Value{} );
         setstate( rdstate() | eofbit );
     }
+}
 
-    return *this;
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+auto istream::get_area_kernel( const Format& fmt, std::true_type ) const -> pcm::read_kernel_t<Value>
+{
+    return pcm::read_kernel<Value>( fmt );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+auto istream::get_area_kernel( const Format&, std::false_type ) const -> std::false_type
+{
+    return {};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Iterator, class Format>
+auto istream::copy_get_area( Iterator beg, Iterator end, const Format&, pcm::read_kernel_t<Value> kernel ) -> Iterator
+{
+    const auto bytes_per_sample = static_cast<std::ptrdiff_t>( m_info->bytes_per_sample() );
+    const auto available        = std::distance( m_streambuf->gptr(), m_streambuf->egptr() ) / bytes_per_sample;
+    const auto count            = std::min( available, static_cast<std::ptrdiff_t>( std::distance( beg, end ) ) );
+
+    kernel( m_streambuf->gptr(), static_cast<size_t>( count ), pcm::detail::to_address( beg ) );
+    m_streambuf->gbump( static_cast<int>( count * bytes_per_sample ) );
+
+    return std::next( beg, count );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Iterator, class Format>
+auto istream::copy_get_area( Iterator beg, Iterator end, const Format& fmt, std::false_type ) -> Iterator
+{
+    auto pcm_beg = pcm::make_iterator<Value>( m_streambuf->gptr(), fmt );
+    auto pcm_end = pcm::make_iterator<Value>( m_streambuf->egptr(), fmt );
+
+    auto result = pcm::copy( pcm_beg, pcm_end, beg, end );
+
+    auto count = static_cast<int>( std::distance( pcm_beg, result.first ) * m_info->bytes_per_sample() );
+    m_streambuf->gbump( count );
+
+    return result.second;
 }
 
 } // namespace audio
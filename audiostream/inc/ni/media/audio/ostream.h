@@ -25,18 +25,26 @@
 #include <ni/media/audio/ostream_info.h>
 #include <ni/media/audio/streambuf.h>
 
+#include <ni/media/pcm/algorithm/convert.h>
 #include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/algorithm/interleave_copy.h>
+#include <ni/media/pcm/detail/contiguous.h>
+#include <ni/media/pcm/dither.h>
 #include <ni/media/pcm/iterator.h>
 
 #include <boost/range/difference_type.hpp>
 #include <boost/range/has_range_iterator.hpp>
+#include <boost/range/iterator.hpp>
 #include <boost/range/value_type.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <ostream>
 #include <type_traits>
+#include <vector>
 
 namespace audio
 {
@@ -65,6 +73,15 @@ public:
     template <class Range>
     auto operator<<( const Range& rng ) -> std::enable_if_t<boost::has_range_iterator<Range>::value, ostream&>;
 
+    // writes frames from one buffer per channel
+    template <class Value>
+    auto write_planar( const Value* const* src, std::streamsize frames ) -> ostream&;
+
+    // dithers floating point values written to integer formats of up to 24 bit.
+    // the state of each channel carries over from one write to the next.
+    auto set_dither( pcm::dither_type type, uint32_t seed = 1 ) -> ostream&;
+    auto dither() const -> pcm::dither_type;
+
     using std::ostream::bad;
     using std::ostream::clear;
     using std::ostream::eof;
@@ -93,8 +110,32 @@ protected:
     ostream& operator=( ostream&& );
 
 private:
+    static constexpr size_t block_size = 4096;
+
+    template <class Value>
+    auto dithered( Value val, std::true_type /*is_float*/ ) -> Value;
+
+    template <class Value>
+    auto dithered( Value val, std::false_type /*is_float*/ ) -> Value;
+
+    template <class Value>
+    void write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel );
+
+    template <class Value>
+    void write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel, std::true_type /*is_float*/ );
+
+    template <class Value>
+    void write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel, std::false_type /*is_float*/ );
+
+    template <class Value, class Iterator>
+    void write_range( Iterator beg, Iterator end, pcm::write_kernel_t<Value> kernel, std::true_type );
+
+    template <class Value, class Iterator>
+    void write_range( Iterator beg, Iterator end, pcm::write_kernel_t<Value> kernel, std::false_type );
+
     std::unique_ptr<streambuf> m_streambuf;
     std::unique_ptr<info_type> m_info;
+    pcm::dither                m_dither;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -103,7 +144,7 @@ template <class Value>
 auto ostream::operator<<( Value val ) -> std::enable_if_t<std::is_arithmetic<Value>::value, ostream&>
 {
     std::array<char, 8> temp;
-    pcm::write( temp.data(), val, m_info->format() );
+    pcm::write( temp.data(), dithered( val, std::is_floating_point<Value>{} ), m_info->format() );
     std::ostream::write( temp.data(), m_info->bytes_per_sample() );
     return *this;
 }
@@ -113,10 +154,155 @@ auto ostream::operator<<( Value val ) -> std::enable_if_t<std::is_arithmetic<Val
 template <class Range>
 auto ostream::operator<<( const Range& rng ) -> std::enable_if_t<boost::has_range_iterator<Range>::value, ostream&>
 {
-    // TODO fast pcm conversion
-    for ( auto val : rng )
-        *this << val;
+    using Value        = typename boost::range_value<Range>::type;
+    using Iterator     = typename boost::range_iterator<const Range>::type;
+    using IsContiguous = pcm::detail::is_contiguous_value_iterator<Iterator, Value>;
+
+    const auto kernel = pcm::write_kernel<Value>( m_info->format() );
+    write_range<Value>( std::begin( rng ), std::end( rng ), kernel, IsContiguous{} );
 
     return *this;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+auto ostream::write_planar( const Value* const* src, std::streamsize frames ) -> ostream&
+{
+    const auto channels        = m_info->num_channels();
+    const auto bytes_per_frame = m_info->bytes_per_frame();
+    const auto block_frames    = std::max( size_t( 1 ), block_size / bytes_per_frame );
+
+    if ( frames <= 0 )
+        return *this;
+
+    auto channel_ptrs = std::vector<const Value*>( src, src + channels );
+
+    if ( std::is_floating_point<Value>::value && m_dither.type() != pcm::dither_type::none )
+    {
+        // interleaved values go through the same dithering as interleaved writes
+        const auto interleave = pcm::detail::interleave_kernel<Value>();
+        const auto kernel     = pcm::write_kernel<Value>( m_info->format() );
+        const auto capacity   = std::min( block_frames, static_cast<size_t>( frames ) ) * channels;
+        auto       values     = std::vector<Value>( capacity );
+
+        for ( size_t offset = 0; offset < static_cast<size_t>( frames ); offset += block_frames )
+        {
+            const auto n = std::min( block_frames, static_cast<size_t>( frames ) - offset );
+            interleave( channel_ptrs.data(), offset, n, channels, values.data() );
+            write_samples( values.data(), n * channels, kernel );
+        }
+        return *this;
+    }
+
+    auto block = std::vector<char>( std::min( block_frames, static_cast<size_t>( frames ) ) * bytes_per_frame );
+
+    for ( auto remaining = static_cast<size_t>( frames ); remaining > 0; )
+    {
+        const auto n = std::min( block_frames, remaining );
+        pcm::interleave_copy( channel_ptrs.data(), n, channels, m_info->format(), block.data() );
+        std::ostream::write( block.data(), static_cast<std::streamsize>( n * bytes_per_frame ) );
+
+        for ( auto& ptr : channel_ptrs )
+            ptr += n;
+        remaining -= n;
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+auto ostream::dithered( Value val, std::true_type /*is_float*/ ) -> Value
+{
+    m_dither.apply( &val, 1, m_info->format(), &val );
+    return val;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+auto ostream::dithered( Value val, std::false_type /*is_float*/ ) -> Value
+{
+    return val;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+void ostream::write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel )
+{
+    write_samples( src, n, kernel, std::is_floating_point<Value>{} );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+void ostream::write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel, std::true_type /*is_float*/ )
+{
+    if ( m_dither.type() == pcm::dither_type::none )
+    {
+        write_samples( src, n, kernel, std::false_type{} );
+        return;
+    }
+
+    std::array<Value, block_size / sizeof( Value )> values;
+    while ( n > 0 )
+    {
+        const auto count = std::min( values.size(), n );
+        m_dither.apply( src, count, m_info->format(), values.data() );
+        write_samples( values.data(), count, kernel, std::false_type{} );
+
+        src += count;
+        n -= count;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value>
+void ostream::write_samples( const Value* src, size_t n, pcm::write_kernel_t<Value> kernel, std::false_type /*is_float*/ )
+{
+    const auto bytes_per_sample = m_info->bytes_per_sample();
+    const auto block_samples    = block_size / bytes_per_sample;
+
+    std::array<char, block_size> block;
+    while ( n > 0 )
+    {
+        const auto count = std::min( block_samples, n );
+        kernel( src, count, block.data() );
+        std::ostream::write( block.data(), static_cast<std::streamsize>( count * bytes_per_sample ) );
+
+        src += count;
+        n -= count;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Iterator>
+void ostream::write_range( Iterator beg, Iterator end, pcm::write_kernel_t<Value> kernel, std::true_type )
+{
+    if ( beg != end )
+        write_samples( pcm::detail::to_address( beg ), static_cast<size_t>( std::distance( beg, end ) ), kernel );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Iterator>
+void ostream::write_range( Iterator beg, Iterator end, pcm::write_kernel_t<Value> kernel, std::false_type )
+{
+    // non contiguous ranges are gathered into a contiguous block first
+    std::array<Value, block_size / sizeof( Value )> values;
+    while ( beg != end )
+    {
+        size_t count = 0;
+        for ( ; count < values.size() && beg != end; ++count, ++beg )
+            values[count] = *beg;
+
+        write_samples( values.data(), count, kernel );
+    }
+}
+
 } // namespace audio
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <ni/media/audio/istream.h>
+
+#include <ni/media/pcm/compiletime_format.h>
+#include <ni/media/pcm/format.h>
+
+#include <boost/range/has_range_iterator.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace audio
+{
+
+// Reads Value from an istream whose format is known at compile time. The format is checked once on
+// construction, reads then convert with the kernel of Format directly instead of resolving the
+// runtime format per refill, and non-contiguous output is converted by compiletime pcm iterators.
+//
+//   auto wav = audio::ifstream( "file.wav" );
+//   auto in  = wav.as<float, pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::little_endian>>();
+//   in >> buffer;
+//
+// The typed_istream refers to the stream, which must outlive it.
+template <class Value, class Format>
+class typed_istream
+{
+public:
+    using value_type  = Value;
+    using format_type = Format;
+
+    explicit typed_istream( istream& stream );
+
+    auto operator>>( Value& val ) -> typed_istream&;
+
+    template <class Range>
+    auto operator>>( Range&& rng ) -> std::enable_if_t<boost::has_range_iterator<Range>::value, typed_istream&>;
+
+    explicit operator bool() const
+    {
+        return bool( *m_stream );
+    }
+
+    auto stream() const -> istream&
+    {
+        return *m_stream;
+    }
+
+    constexpr auto format() const -> Format
+    {
+        return {};
+    }
+
+private:
+    istream* m_stream;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+typed_istream<Value, Format>::typed_istream( istream& stream )
+: m_stream( &stream )
+{
+    if ( stream.info().format() != pcm::format( Format{} ) )
+        throw std::runtime_error( "Stream format does not match the requested compiletime format" );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+auto typed_istream<Value, Format>::operator>>( Value& val ) -> typed_istream&
+{
+    m_stream->read_sample( val, Format{} );
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+template <class Range>
+auto typed_istream<Value, Format>::operator>>( Range&& rng )
+    -> std::enable_if_t<boost::has_range_iterator<Range>::value, typed_istream&>
+{
+    static_assert( std::is_same<typename boost::range_value<Range>::type, Value>::value,
+                   "typed_istream reads ranges of its value type only" );
+
+    m_stream->read_samples<Value>( std::begin( rng ), std::end( rng ), Format{} );
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <class Value, class Format>
+auto istream::as( Format ) -> typed_istream<Value, Format>
+{
+    return typed_istream<Value, Format>( *this );
+}
+
+} // namespace audio
@@ -45,6 +45,7 @@ ostream::ostream( ostream&& other )
 : std::ostream( std::move( other ) )
 , m_streambuf( std::move( other.m_streambuf ) )
 , m_info( std::move( other.m_info ) )
+, m_dither( std::move( other.m_dither ) )
 {
     set_rdbuf( m_streambuf.get() );
 }
@@ -56,6 +57,7 @@ auto ostream::operator=( ostream&& other ) -> ostream&
     std::ostream::operator=( std::move( other ) );
     m_info                = std::move( other.m_info );
     m_streambuf           = std::move( other.m_streambuf );
+    m_dither              = std::move( other.m_dither );
     std::ostream::set_rdbuf( m_streambuf.get() );
     return *this;
 }
@@ -70,6 +72,21 @@ auto ostream::write( const char_type* s, std::streamsize n ) -> ostream&
 
 //----------------------------------------------------------------------------------------------------------------------
 
+auto ostream::set_dither( pcm::dither_type type, uint32_t seed ) -> ostream&
+{
+    m_dither = pcm::dither( type, m_info->num_channels(), seed );
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+auto ostream::dither() const -> pcm::dither_type
+{
+    return m_dither.type();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 auto ostream::sample_tellp() -> pos_type
 {
     return tellp() / m_info->bytes_per_sample();
@@ -29,6 +29,7 @@
 #include <ni/media/iostreams/device/subview.h>
 #include <ni/media/iostreams/write_obj.h>
 
+#include <boost/range/algorithm/copy.hpp>
 #include <boost/range/algorithm/equal.hpp>
 
 #include <cassert>
@@ -38,6 +39,21 @@
 namespace detail
 {
 
+inline auto wav_format_tag( pcm::number_type number ) -> uint16_t
+{
+    switch ( number )
+    {
+        case pcm::floating_point:
+            return wavFormatTagIeeeFloat;
+        case pcm::alaw:
+            return wavFormatTagALaw;
+        case pcm::ulaw:
+            return wavFormatTagMuLaw;
+        default:
+            return wavFormatTagPcm;
+    }
+}
+
 template <class Sink>
 auto write_wav_header( Sink& sink )
 {
@@ -60,13 +76,16 @@ auto write_wav_header( Sink& sink )
     curChunk = little_endian_fourcc( "fmt " );
     write_obj( sink, curChunk );
 
+    // padded formats need WAVE_FORMAT_EXTENSIBLE to carry their valid bits
+    const auto format     = sink.info().format();
+    const bool extensible = format.valid_bits() != format.bitwidth();
+
     // subChunk1Size, 16 if PCM
-    uint32_t subChunk1Size = 16;
+    uint32_t subChunk1Size = extensible ? 40 : 16;
     write_obj( sink, subChunk1Size );
 
     // audioFormat
-    uint16_t audioFormat =
-        sink.info().format().number() == pcm::floating_point ? wavFormatTagIeeeFloat : wavFormatTagPcm;
+    uint16_t audioFormat = extensible ? wavFormatTagExtensible : wav_format_tag( format.number() );
     write_obj( sink, audioFormat );
 
     // numChannels
@@ -89,6 +108,17 @@ auto write_wav_header( Sink& sink )
     uint16_t bits_per_sample = static_cast<uint16_t>( sink.info().bits_per_sample() );
     write_obj( sink, bits_per_sample );
 
+    if ( extensible )
+    {
+        // cbSize
+        write_obj( sink, uint16_t( sizeof( wav::FormatExtensible ) ) );
+
+        wav::FormatExtensible formatExtensible;
+        formatExtensible.validBitsPerSample = static_cast<uint16_t>( format.valid_bits() );
+        boost::copy( wavFormatExtSubFormatPCM, formatExtensible.subFormat );
+        write_obj( sink, formatExtensible );
+    }
+
     // DATA, aka subChunk2Tag
     curChunk = little_endian_fourcc( "data" );
     write_obj( sink, curChunk );
@@ -29,6 +29,7 @@
 #include <ni/media/iostreams/device/subview.h>
 #include <ni/media/iostreams/fetch.h>
 
+#include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/equal.hpp>
 
 #include <cassert>
@@ -40,6 +41,17 @@
 namespace detail
 {
 
+// Samples are stored msb aligned, so valid bits without a dedicated format are read as their container.
+inline bool is_padded_format_supported( size_t bits, size_t validBits )
+{
+    const auto matches = [bits, validBits]( const auto& fmt ) {
+        return fmt.number() == pcm::signed_integer && fmt.endian() == pcm::little_endian && fmt.bitwidth() == bits
+               && fmt.valid_bits() == validBits;
+    };
+
+    return validBits < bits && boost::algorithm::any_of( pcm::runtime_formats(), matches );
+}
+
 template <class Source>
 auto readWavHeader( Source& src )
 {
@@ -79,6 +91,8 @@ auto readWavHeader( Source& src )
             if ( fmtChunk.blockAlign == 0 || fmtChunk.blockAlign * 8 != fmtChunk.bitsPerSample * fmtChunk.numChannels )
                 throw std::runtime_error( "Invalid block align" );
 
+            auto validBitsPerSample = fmtChunk.bitsPerSample;
+
             if ( riffTag.length >= sizeof( FmtChunk ) + sizeof( ExtensionSize ) + sizeof( FormatExtensible ) )
             {
                 ExtensionSize extensionSize;
@@ -95,6 +109,10 @@ auto readWavHeader( Source& src )
                     if ( boost::equal( formatExtensible.subFormat, wavFormatExtSubFormatPCM ) )
                     {
                         fmtChunk.formatTag = wavFormatTagPcm;
+
+                        if ( formatExtensible.validBitsPerSample > 0
+                             && formatExtensible.validBitsPerSample < fmtChunk.bitsPerSample )
+                            validBitsPerSample = formatExtensible.validBitsPerSample;
                     }
                     else if ( boost::equal( formatExtensible.subFormat, wavFormatExtSubFormatFloat ) )
                     {
@@ -109,6 +127,9 @@ auto readWavHeader( Source& src )
             {
                 if ( 8 == fmtChunk.bitsPerSample )
                     format = pcm::format( pcm::unsigned_integer, fmtChunk.bitsPerSample );
+                else if ( is_padded_format_supported( fmtChunk.bitsPerSample, validBitsPerSample ) )
+                    format = pcm::format(
+                        pcm::signed_integer, fmtChunk.bitsPerSample, pcm::little_endian, validBitsPerSample );
                 else
                     format = pcm::format( pcm::signed_integer, fmtChunk.bitsPerSample, pcm::little_endian );
             }
@@ -116,13 +137,14 @@ auto readWavHeader( Source& src )
             {
                 format = pcm::format( pcm::floating_point, fmtChunk.bitsPerSample, pcm::little_endian );
             }
-            else if ( fmtChunk.formatTag == wavFormatTagALaw )
-            {
-                throw std::runtime_error( "ALaw format is not supported" );
-            }
-            else if ( fmtChunk.formatTag == wavFormatTagMuLaw )
+            else if ( fmtChunk.formatTag == wavFormatTagALaw || fmtChunk.formatTag == wavFormatTagMuLaw )
             {
-                throw std::runtime_error( "uLaw format is not supported" );
+                if ( 8 != fmtChunk.bitsPerSample )
+                    throw std::runtime_error( "Invalid bits per sample for companded format: "
+                                              + std::to_string( fmtChunk.bitsPerSample ) );
+
+                const auto number = fmtChunk.formatTag == wavFormatTagALaw ? pcm::alaw : pcm::ulaw;
+                format            = pcm::format( number, fmtChunk.bitsPerSample, pcm::little_endian );
             }
             else
             {
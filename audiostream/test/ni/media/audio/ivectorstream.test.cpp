@@ -23,9 +23,12 @@
 #include <gtest/gtest.h>
 
 #include <ni/media/audio/ivectorstream.h>
+#include <ni/media/audio/typed_istream.h>
 
 #include <boost/range/algorithm/equal.hpp>
 
+#include <list>
+
 //----------------------------------------------------------------------------------------------------------------------
 
 TEST( ni_media_audio_ivectorstream, default_constructor )
@@ -113,3 +116,82 @@ TEST( ni_media_audio_ivectorstream, move_assignment )
     EXPECT_EQ( -1, is2.tellg() );
     EXPECT_TRUE( is2.eof() );
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( ni_media_audio_ivectorstream, half_float_buffer )
+{
+    // multiples of 1/64 in [-2, 2) are exact in binary16
+    std::vector<float> expected( 256 );
+    for ( size_t i = 0; i < expected.size(); ++i )
+        expected[i] = float( int( i ) - 128 ) / 64;
+
+    audio::ivectorstream::info_type info;
+    info.format( pcm::format( "f16le" ) );
+
+    std::vector<char> in( expected.size() * 2 );
+    for ( size_t i = 0; i < expected.size(); ++i )
+        pcm::write( in.data() + i * 2, expected[i], info.format() );
+
+    audio::ivectorstream is( in, info );
+
+    std::vector<float> out( expected.size() );
+    is >> out;
+
+    EXPECT_TRUE( boost::equal( expected, out ) );
+    EXPECT_EQ( audio::ivectorstream::pos_type( in.size() ), is.tellg() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( ni_media_audio_ivectorstream, typed_istream_matches_runtime_reads )
+{
+    using s24le = pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::little_endian>;
+
+    audio::ivectorstream::info_type info;
+    info.format( s24le{} );
+
+    std::vector<char> in( 3 * 5000 );
+    for ( size_t i = 0; i < in.size(); ++i )
+        in[i] = char( i * 7 );
+
+    audio::ivectorstream runtime_is( in, info );
+    audio::ivectorstream typed_is( in, info );
+
+    auto typed = typed_is.as<float, s24le>();
+
+    float runtime_val, typed_val;
+    runtime_is >> runtime_val;
+    typed >> typed_val;
+    EXPECT_EQ( runtime_val, typed_val );
+
+    std::vector<float> expected( 4000 );
+    std::vector<float> actual( expected.size() );
+    runtime_is >> expected;
+    typed >> actual;
+    EXPECT_TRUE( boost::equal( expected, actual ) );
+
+    std::list<float> expected_list( 1500 );
+    std::list<float> actual_list( expected_list.size() );
+    runtime_is >> expected_list;
+    typed >> actual_list;
+    EXPECT_TRUE( boost::equal( expected_list, actual_list ) );
+    EXPECT_EQ( runtime_is.eof(), typed_is.eof() );
+    EXPECT_TRUE( bool( typed ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( ni_media_audio_ivectorstream, typed_istream_throws_on_format_mismatch )
+{
+    using s16le = pcm::compiletime_format<pcm::signed_integer, pcm::_16bit, pcm::little_endian>;
+    using s24le = pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::little_endian>;
+
+    audio::ivectorstream::info_type info;
+    info.format( s16le{} );
+
+    audio::ivectorstream is( std::vector<char>( 8 ), info );
+
+    EXPECT_THROW( is.as<float>( s24le{} ), std::runtime_error );
+    EXPECT_NO_THROW( is.as<float>( s16le{} ) );
+}
@@ -26,6 +26,12 @@
 
 #include <ni/media/sink_test.h>
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <vector>
+
 //----------------------------------------------------------------------------------------------------------------------
 
 class wav_sink_test : public sink_test
@@ -59,3 +65,206 @@ INSTANTIATE_TEST_SUITE_P( reference_test,
                           ParamToString{} );
 
 //----------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+auto read_file( const std::string& name )
+{
+    std::ifstream file( name, std::ios::binary );
+    return std::vector<char>( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>{} );
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( wav_sink_planar_test, write_planar_equals_interleaved_write )
+{
+    const size_t num_frames   = 3001;
+    const size_t num_channels = 6;
+
+    auto planar = std::vector<std::vector<float>>( num_channels, std::vector<float>( num_frames ) );
+    for ( size_t c = 0; c < num_channels; ++c )
+        for ( size_t f = 0; f < num_frames; ++f )
+            planar[c][f] = float( ( f * ( c + 1 ) ) % 301 ) / 150.f - 1.f;
+
+    auto interleaved = std::vector<float>{};
+    for ( size_t f = 0; f < num_frames; ++f )
+        for ( size_t c = 0; c < num_channels; ++c )
+            interleaved.push_back( planar[c][f] );
+
+    auto channels = std::vector<const float*>{};
+    for ( const auto& channel : planar )
+        channels.push_back( channel.data() );
+
+    const auto interleaved_name = ( test_files_output_path() / "write_interleaved.wav" ).string();
+    const auto list_name        = ( test_files_output_path() / "write_list.wav" ).string();
+    const auto planar_name      = ( test_files_output_path() / "write_planar.wav" ).string();
+
+    for ( auto format : {"s16le", "s24le", "s32le", "f32le", "a8le", "m8le", "s24in32le"} )
+    {
+        audio::wav_ofstream_info info;
+        info.format( pcm::format( format ) );
+        info.num_channels( num_channels );
+
+        audio::wav_ofstream( interleaved_name, info ) << interleaved;
+        audio::wav_ofstream( list_name, info ) << std::list<float>( interleaved.begin(), interleaved.end() );
+        audio::wav_ofstream( planar_name, info ).write_planar( channels.data(), num_frames );
+
+        const auto expected = read_file( interleaved_name );
+        EXPECT_LT( interleaved.size() * info.bytes_per_sample(), expected.size() ) << format;
+        EXPECT_EQ( expected, read_file( list_name ) ) << format;
+        EXPECT_EQ( expected, read_file( planar_name ) ) << format;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( wav_sink_companded_test, read_back_equals_companded_values )
+{
+    const size_t num_frames   = 1001;
+    const size_t num_channels = 2;
+
+    auto interleaved = std::vector<float>( num_frames * num_channels );
+    for ( size_t i = 0; i < interleaved.size(); ++i )
+        interleaved[i] = float( ( i * 13 ) % 2001 ) / 1000.f - 1.f;
+
+    const auto name = ( test_files_output_path() / "companded.wav" ).string();
+
+    for ( auto format : {"a8le", "m8le"} )
+    {
+        audio::wav_ofstream_info info;
+        info.format( pcm::format( format ) );
+        info.num_channels( num_channels );
+
+        audio::wav_ofstream( name, info ) << interleaved;
+
+        auto expected = std::vector<float>( interleaved.size() );
+        for ( size_t i = 0; i < interleaved.size(); ++i )
+        {
+            char code;
+            pcm::write( &code, interleaved[i], info.format() );
+            expected[i] = pcm::read<float>( &code, info.format() );
+        }
+
+        audio::ifstream is( name );
+        EXPECT_EQ( info.format(), is.info().format() ) << format;
+        EXPECT_EQ( num_frames, is.info().num_frames() ) << format;
+
+        auto actual = std::vector<float>( interleaved.size() );
+        is >> actual;
+        EXPECT_EQ( expected, actual ) << format;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( wav_sink_padded_test, read_back_keeps_valid_bits )
+{
+    const size_t num_frames   = 1001;
+    const size_t num_channels = 2;
+
+    auto interleaved = std::vector<float>( num_frames * num_channels );
+    for ( size_t i = 0; i < interleaved.size(); ++i )
+        interleaved[i] = float( ( i * 13 ) % 2001 ) / 1000.f - 1.f;
+
+    const auto name = ( test_files_output_path() / "padded.wav" ).string();
+
+    for ( auto format : {"s12in16le", "s20in24le", "s24in32le"} )
+    {
+        audio::wav_ofstream_info info;
+        info.format( pcm::format( format ) );
+        info.num_channels( num_channels );
+
+        audio::wav_ofstream( name, info ) << interleaved;
+
+        // WAVE_FORMAT_EXTENSIBLE with wValidBitsPerSample
+        const auto file       = read_file( name );
+        uint16_t   format_tag = 0;
+        uint16_t   valid_bits = 0;
+        std::memcpy( &format_tag, file.data() + 20, sizeof( format_tag ) );
+        std::memcpy( &valid_bits, file.data() + 38, sizeof( valid_bits ) );
+        EXPECT_EQ( 0xfffe, format_tag ) << format;
+        EXPECT_EQ( info.format().valid_bits(), valid_bits ) << format;
+
+        auto expected = std::vector<float>( interleaved.size() );
+        for ( size_t i = 0; i < interleaved.size(); ++i )
+        {
+            char sample[4];
+            pcm::write( sample, interleaved[i], info.format() );
+            expected[i] = pcm::read<float>( sample, info.format() );
+        }
+
+        audio::ifstream is( name );
+        EXPECT_EQ( info.format(), is.info().format() ) << format;
+        EXPECT_EQ( num_frames, is.info().num_frames() ) << format;
+
+        auto actual = std::vector<float>( interleaved.size() );
+        is >> actual;
+        EXPECT_EQ( expected, actual ) << format;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( wav_sink_dither_test, dithered_writes_match_dithered_values )
+{
+    const size_t num_frames   = 2001;
+    const size_t num_channels = 2;
+
+    auto interleaved = std::vector<float>( num_frames * num_channels );
+    for ( size_t i = 0; i < interleaved.size(); ++i )
+        interleaved[i] = float( ( i * 7 ) % 1001 ) / 1000.f - 0.5f;
+
+    auto planar = std::vector<std::vector<float>>( num_channels, std::vector<float>( num_frames ) );
+    for ( size_t f = 0; f < num_frames; ++f )
+        for ( size_t c = 0; c < num_channels; ++c )
+            planar[c][f] = interleaved[f * num_channels + c];
+
+    auto channels = std::vector<const float*>{};
+    for ( const auto& channel : planar )
+        channels.push_back( channel.data() );
+
+    const auto expected_name = ( test_files_output_path() / "dither_expected.wav" ).string();
+    const auto actual_name   = ( test_files_output_path() / "dither_actual.wav" ).string();
+
+    for ( auto type : {pcm::dither_type::tpdf, pcm::dither_type::second_order_shaped} )
+    {
+        audio::wav_ofstream_info info;
+        info.format( pcm::format( "s16le" ) );
+        info.num_channels( num_channels );
+
+        auto dithered = std::vector<float>( interleaved.size() );
+        pcm::dither( type, num_channels ).apply( interleaved.data(), interleaved.size(), info.format(), dithered.data() );
+        audio::wav_ofstream( expected_name, info ) << dithered;
+        const auto expected = read_file( expected_name );
+
+        {
+            auto os = audio::wav_ofstream( actual_name, info );
+            os.set_dither( type );
+            EXPECT_EQ( type, os.dither() );
+            os << interleaved;
+        }
+        EXPECT_EQ( expected, read_file( actual_name ) ) << int( type );
+
+        {
+            auto os = audio::wav_ofstream( actual_name, info );
+            os.set_dither( type ).write_planar( channels.data(), num_frames );
+        }
+        EXPECT_EQ( expected, read_file( actual_name ) ) << int( type );
+
+        {
+            auto os = audio::wav_ofstream( actual_name, info );
+            os.set_dither( type ) << std::list<float>( interleaved.begin(), interleaved.begin() + 11 );
+            for ( auto it = interleaved.begin() + 11; it != interleaved.end(); ++it )
+                os << *it;
+        }
+        EXPECT_EQ( expected, read_file( actual_name ) ) << int( type );
+
+        audio::wav_ofstream( actual_name, info ) << interleaved;
+        EXPECT_NE( expected, read_file( actual_name ) ) << int( type );
+    }
+}
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Instantiates the dispatched pcm algorithms the way applications use them, with runtime formats on
+// both sides. Built once with all formats and once with NIMEDIA_PCM_COMMON_DISPATCH_FORMATS, so the
+// pcm_dispatch_size target can report how much code the dispatch adds for either set.
+
+#undef NIMEDIA_PCM_COMMON_DISPATCH_FORMATS
+#define NIMEDIA_PCM_COMMON_DISPATCH_FORMATS NIMEDIA_PCM_DISPATCH_SIZE_COMMON
+
+#include <ni/media/pcm/algorithm.h>
+#include <ni/media/pcm/iterator.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dispatch_size
+{
+
+template <class Value>
+void read( const std::vector<char>& in, pcm::format fmt, std::vector<Value>& out )
+{
+    pcm::copy( pcm::make_iterator<Value>( in.begin(), fmt ), pcm::make_iterator<Value>( in.end(), fmt ), out.begin() );
+}
+
+template <class Value>
+void write( const std::vector<Value>& in, pcm::format fmt, std::vector<char>& out )
+{
+    pcm::copy( in.begin(), in.end(), pcm::make_iterator<Value>( out.begin(), fmt ) );
+}
+
+void read_float( const std::vector<char>& in, pcm::format fmt, std::vector<float>& out )
+{
+    read( in, fmt, out );
+}
+
+void read_int16( const std::vector<char>& in, pcm::format fmt, std::vector<int16_t>& out )
+{
+    read( in, fmt, out );
+}
+
+void read_int32( const std::vector<char>& in, pcm::format fmt, std::vector<int32_t>& out )
+{
+    read( in, fmt, out );
+}
+
+void write_float( const std::vector<float>& in, pcm::format fmt, std::vector<char>& out )
+{
+    write( in, fmt, out );
+}
+
+void write_int16( const std::vector<int16_t>& in, pcm::format fmt, std::vector<char>& out )
+{
+    write( in, fmt, out );
+}
+
+void write_int32( const std::vector<int32_t>& in, pcm::format fmt, std::vector<char>& out )
+{
+    write( in, fmt, out );
+}
+
+// pcm to pcm, instantiated for every pair of formats
+void transcode( const std::vector<char>& in, pcm::format in_fmt, std::vector<char>& out, pcm::format out_fmt )
+{
+    pcm::copy( pcm::make_iterator<float>( in.begin(), in_fmt ),
+               pcm::make_iterator<float>( in.end(), in_fmt ),
+               pcm::make_iterator<float>( out.begin(), out_fmt ) );
+}
+
+float peak( const std::vector<char>& in, pcm::format fmt )
+{
+    return pcm::peak( pcm::make_iterator<float>( in.begin(), fmt ), pcm::make_iterator<float>( in.end(), fmt ) );
+}
+
+} // namespace dispatch_size
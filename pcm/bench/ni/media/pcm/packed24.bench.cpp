@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Compares the packed 24 bit word-load kernels against the byte-wise intermediate<Format> loop.
+
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/detail/kernels.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t num_samples    = 1 << 16;
+constexpr int    num_iterations = 500;
+
+template <class Function>
+double ns_per_sample( Function function )
+{
+    // warm up caches and the kernel selection
+    function();
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < num_iterations; ++i )
+        function();
+    const auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>( stop - start ).count() / ( double( num_iterations ) * num_samples );
+}
+
+void report( const char* name, double byte_loop, double scalar, double best )
+{
+    std::printf( "%-14s %10.3f %10.3f %10.3f %9.2fx %9.2fx\n",
+                 name,
+                 byte_loop,
+                 scalar,
+                 best,
+                 byte_loop / scalar,
+                 byte_loop / best );
+}
+
+template <class Format>
+void bench_read( const char* name )
+{
+    auto engine = std::mt19937{42};
+    auto src    = std::vector<char>( num_samples * 3 );
+    std::generate( src.begin(), src.end(), [&engine] { return char( engine() ); } );
+    auto dst = std::vector<float>( num_samples );
+
+    const auto byte_loop = ns_per_sample( [&] {
+        auto in = src.data();
+        for ( auto& value : dst )
+        {
+            value = pcm::detail::read_impl<float, const char*, Format>( in );
+            in += 3;
+        }
+    } );
+
+    const auto scalar = ns_per_sample( [&] { pcm::detail::scalar::read<float, Format>( src.data(), num_samples, dst.data() ); } );
+
+    const auto kernel = pcm::detail::read_kernel<float, Format>();
+    const auto best   = ns_per_sample( [&] { kernel( src.data(), num_samples, dst.data() ); } );
+
+    report( name, byte_loop, scalar, best );
+}
+
+template <class Format>
+void bench_write( const char* name )
+{
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<float>( -1.f, 1.f );
+    auto src    = std::vector<float>( num_samples );
+    std::generate( src.begin(), src.end(), [&] { return dist( engine ); } );
+    auto dst = std::vector<char>( num_samples * 3 );
+
+    const auto byte_loop = ns_per_sample( [&] {
+        auto out = dst.data();
+        for ( auto value : src )
+        {
+            pcm::detail::write_impl<float, char*, Format>( out, value );
+            out += 3;
+        }
+    } );
+
+    const auto scalar = ns_per_sample( [&] { pcm::detail::scalar::write<float, Format>( src.data(), num_samples, dst.data() ); } );
+
+    const auto kernel = pcm::detail::write_kernel<float, Format>();
+    const auto best   = ns_per_sample( [&] { kernel( src.data(), num_samples, dst.data() ); } );
+
+    report( name, byte_loop, scalar, best );
+}
+
+} // namespace
+
+int main()
+{
+    using s24le = pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::little_endian>;
+    using s24be = pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::big_endian>;
+    using u24le = pcm::compiletime_format<pcm::unsigned_integer, pcm::_24bit, pcm::little_endian>;
+    using u24be = pcm::compiletime_format<pcm::unsigned_integer, pcm::_24bit, pcm::big_endian>;
+
+    std::printf( "ns per sample, %zu samples, float <-> packed 24 bit\n\n", num_samples );
+    std::printf( "%-14s %10s %10s %10s %10s %10s\n", "", "byte loop", "word load", "best", "word/byte", "best/byte" );
+
+    bench_read<s24le>( "read s24le" );
+    bench_read<s24be>( "read s24be" );
+    bench_read<u24le>( "read u24le" );
+    bench_read<u24be>( "read u24be" );
+
+    bench_write<s24le>( "write s24le" );
+    bench_write<s24be>( "write s24be" );
+    bench_write<u24le>( "write u24le" );
+    bench_write<u24be>( "write u24be" );
+
+    return 0;
+}
@@ -20,5 +20,15 @@
 // SOFTWARE.
 //
 
+#include <ni/media/pcm/algorithm/accumulate.h>
+#include <ni/media/pcm/algorithm/convert.h>
 #include <ni/media/pcm/algorithm/copy.h>
 #include <ni/media/pcm/algorithm/copy_n.h>
+#include <ni/media/pcm/algorithm/copy_transform.h>
+#include <ni/media/pcm/algorithm/deinterleave_copy.h>
+#include <ni/media/pcm/algorithm/find_first_above.h>
+#include <ni/media/pcm/algorithm/interleave_copy.h>
+#include <ni/media/pcm/algorithm/min_max.h>
+#include <ni/media/pcm/algorithm/peak.h>
+#include <ni/media/pcm/algorithm/sum_of_squares.h>
+#include <ni/media/pcm/algorithm/transcode.h>
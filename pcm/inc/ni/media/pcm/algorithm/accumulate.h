@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/reduce.h>
+#include <ni/media/pcm/dispatch.h>
+
+#include <iterator>
+#include <numeric>
+
+namespace pcm
+{
+namespace detail
+{
+
+struct accumulate_impl
+{
+    template <class InputIt, class T>
+    T operator()( InputIt beg, InputIt end, T init ) const
+    {
+        return std::accumulate( beg, end, init );
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class T,
+              class = enable_if_contiguous_reduce_t<Value, Iterator>>
+    T operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                  contiguous_iterator<Value, Iterator, n, b, e, v> end,
+                  T                                                init ) const
+    {
+        const auto sum = reduce_kernels<Value>().sum;
+
+        double result = 0;
+        for_each_block( beg, end, [&]( const Value* block, size_t size, size_t ) {
+            result = sum( block, size, result );
+            return true;
+        } );
+        return init + T( result );
+    }
+};
+
+} // namespace detail
+
+// init plus the sum of all samples. Contiguous pcm data is summed in double with partial sums,
+// so the result may differ from std::accumulate in the last bits.
+template <class InputIt, class T>
+T accumulate( InputIt beg, InputIt end, T init )
+{
+    return dispatch( detail::accumulate_impl{}, beg, end, init );
+}
+
+template <class InputRange, class T>
+T accumulate( const InputRange& range, T init )
+{
+    return ::pcm::accumulate( std::begin( range ), std::end( range ), init );
+}
+
+} // namespace pcm
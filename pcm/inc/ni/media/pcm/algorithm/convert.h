@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/compiletime_format.h>
+#include <ni/media/pcm/detail/kernels.h>
+#include <ni/media/pcm/runtime_format.h>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+
+namespace pcm
+{
+
+// A block conversion kernel converts n samples between raw pcm data and values in one call.
+// Resolving a runtime_format to a kernel is the only dispatch step, so callers converting many
+// blocks of the same format should resolve the kernel once and keep it around.
+
+template <class Value>
+using read_kernel_t = detail::read_kernel_t<Value>;
+
+template <class Value>
+using write_kernel_t = detail::write_kernel_t<Value>;
+
+namespace detail
+{
+
+template <class Value, class... Ts>
+auto make_read_kernels( const std::tuple<Ts...>& ) -> std::array<read_kernel_t<Value>, sizeof...( Ts )>
+{
+    return {{read_kernel<Value, Ts>()...}};
+}
+
+template <class Value, class... Ts>
+auto make_write_kernels( const std::tuple<Ts...>& ) -> std::array<write_kernel_t<Value>, sizeof...( Ts )>
+{
+    return {{write_kernel<Value, Ts>()...}};
+}
+
+} // namespace detail
+
+template <class Value, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+auto read_kernel( const compiletime_format<n, b, e, v>& ) -> read_kernel_t<Value>
+{
+    return detail::read_kernel<Value, compiletime_format<n, b, e, v>>();
+}
+
+template <class Value>
+auto read_kernel( const runtime_format& fmt ) -> read_kernel_t<Value>
+{
+    static const auto kernels = detail::make_read_kernels<Value>( compiletime_formats() );
+    return kernels.at( fmt.index() );
+}
+
+template <class Value, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+auto write_kernel( const compiletime_format<n, b, e, v>& ) -> write_kernel_t<Value>
+{
+    return detail::write_kernel<Value, compiletime_format<n, b, e, v>>();
+}
+
+template <class Value>
+auto write_kernel( const runtime_format& fmt ) -> write_kernel_t<Value>
+{
+    static const auto kernels = detail::make_write_kernels<Value>( compiletime_formats() );
+    return kernels.at( fmt.index() );
+}
+
+// converts n samples of pcm data in format fmt starting at src to values starting at dst
+template <class Value, class Format>
+void convert( const char* src, std::size_t n, const Format& fmt, Value* dst )
+{
+    read_kernel<Value>( fmt )( src, n, dst );
+}
+
+// converts n values starting at src to pcm data in format fmt starting at dst
+template <class Value, class Format>
+void convert( const Value* src, std::size_t n, const Format& fmt, char* dst )
+{
+    write_kernel<Value>( fmt )( src, n, dst );
+}
+
+} // namespace pcm
@@ -22,9 +22,18 @@
 
 #pragma once
 
+#include <ni/media/pcm/algorithm/convert.h>
+#include <ni/media/pcm/detail/contiguous.h>
+#include <ni/media/pcm/detail/kernels.h>
 #include <ni/media/pcm/dispatch.h>
+#include <ni/media/pcm/dither.h>
+#include <ni/media/pcm/parallel.h>
+#include <ni/media/pcm/range/segmented.h>
 
 #include <algorithm>
+#include <array>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace pcm
@@ -32,6 +41,42 @@ namespace pcm
 namespace detail
 {
 
+template <class Value, class Iterator, class OutputIt>
+using enable_if_contiguous_read_t = std::enable_if_t<is_contiguous_byte_iterator<Iterator>::value
+                                                     && is_contiguous_value_iterator<OutputIt, Value>::value>;
+
+template <class Value, class Iterator, class InputIt>
+using enable_if_contiguous_write_t = std::enable_if_t<is_contiguous_byte_iterator<Iterator>::value
+                                                      && !is_const_iterator<Iterator>::value
+                                                      && is_contiguous_value_iterator<InputIt, Value>::value>;
+
+// converts n samples at once with the best kernel available for the current cpu
+template <class Value, class Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v, class OutputIt>
+auto read_contiguous( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                      typename std::iterator_traits<OutputIt>::difference_type count,
+                      OutputIt out )
+{
+    if ( count > 0 )
+    {
+        auto kernel = read_kernel<Value, compiletime_format<n, b, e, v>>();
+        kernel( reinterpret_cast<const char*>( to_address( beg.base() ) ), size_t( count ), to_address( out ) );
+    }
+    return std::make_pair( std::next( beg, count ), std::next( out, count ) );
+}
+
+template <class InputIt, class Value, class Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+auto write_contiguous( InputIt beg,
+                       typename std::iterator_traits<InputIt>::difference_type count,
+                       contiguous_iterator<Value, Iterator, n, b, e, v> out )
+{
+    if ( count > 0 )
+    {
+        auto kernel = write_kernel<Value, compiletime_format<n, b, e, v>>();
+        kernel( to_address( beg ), size_t( count ), reinterpret_cast<char*>( to_address( out.base() ) ) );
+    }
+    return std::make_pair( std::next( beg, count ), std::next( out, count ) );
+}
+
 struct copy_impl
 {
     template <class InputIt, class OutputIt>
@@ -47,8 +92,254 @@ struct copy_impl
             *obeg = *ibeg;
         return std::make_pair( ibeg, obeg );
     }
+
+    // contiguous pcm -> contiguous values
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class OutputIt,
+              class = enable_if_contiguous_read_t<Value, Iterator, OutputIt>>
+    OutputIt operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                         contiguous_iterator<Value, Iterator, n, b, e, v> end,
+                         OutputIt                                         out ) const
+    {
+        return read_contiguous( beg, std::distance( beg, end ), out ).second;
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class OutputIt,
+              class = enable_if_contiguous_read_t<Value, Iterator, OutputIt>>
+    auto operator()( contiguous_iterator<Value, Iterator, n, b, e, v> ibeg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> iend,
+                     OutputIt                                         obeg,
+                     OutputIt                                         oend ) const
+    {
+        return read_contiguous( ibeg, std::min( std::distance( ibeg, iend ), std::distance( obeg, oend ) ), obeg );
+    }
+
+    // contiguous values -> contiguous pcm
+
+    template <class InputIt,
+              class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_write_t<Value, Iterator, InputIt>>
+    auto operator()( InputIt beg, InputIt end, contiguous_iterator<Value, Iterator, n, b, e, v> out ) const
+    {
+        return write_contiguous( beg, std::distance( beg, end ), out ).second;
+    }
+
+    template <class InputIt,
+              class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_write_t<Value, Iterator, InputIt>>
+    auto operator()( InputIt                                          ibeg,
+                     InputIt                                          iend,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> obeg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> oend ) const
+    {
+        return write_contiguous( ibeg, std::min( std::distance( ibeg, iend ), std::distance( obeg, oend ) ), obeg );
+    }
+};
+
+// floating point values are dithered in blocks on their way to pcm data, everything else is a plain copy
+struct dither_copy_impl
+{
+    dither* m_dither;
+
+    template <class InputIt, class OutputIt>
+    OutputIt operator()( InputIt beg, InputIt end, OutputIt out ) const
+    {
+        return std::copy( beg, end, out );
+    }
+
+    template <class InputIt,
+              class Value,
+              class Iterator,
+              class Format,
+              class Category,
+              class = std::enable_if_t<std::is_floating_point<Value>::value>>
+    auto operator()( InputIt beg, InputIt end, iterator<Value, Iterator, Format, Category> out ) const
+    {
+        std::array<Value, planar_block_size> block;
+        while ( beg != end )
+        {
+            size_t count = 0;
+            for ( ; count < block.size() && beg != end; ++count, ++beg )
+                block[count] = *beg;
+
+            m_dither->apply( block.data(), count, out.format(), block.data() );
+            out = copy_impl{}( block.data(), block.data() + count, out );
+        }
+        return out;
+    }
 };
 
+// contiguous conversions are split into chunks converted concurrently, everything else is a plain copy
+struct parallel_copy_impl
+{
+    const parallel_policy* m_policy;
+
+    template <class InputIt, class OutputIt>
+    OutputIt operator()( InputIt beg, InputIt end, OutputIt out ) const
+    {
+        return copy_impl{}( beg, end, out );
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class OutputIt,
+              class = enable_if_contiguous_read_t<Value, Iterator, OutputIt>>
+    OutputIt operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                         contiguous_iterator<Value, Iterator, n, b, e, v> end,
+                         OutputIt                                         out ) const
+    {
+        using difference_type = typename std::iterator_traits<OutputIt>::difference_type;
+
+        const auto count = std::distance( beg, end );
+        const auto chunk = m_policy->chunk_size( b / 8 );
+        parallel_for_chunks( *m_policy, size_t( count ), chunk, [=]( size_t offset, size_t size ) {
+            read_contiguous( std::next( beg, offset ), difference_type( size ), std::next( out, offset ) );
+        } );
+        return std::next( out, count );
+    }
+
+    template <class InputIt,
+              class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_write_t<Value, Iterator, InputIt>>
+    auto operator()( InputIt beg, InputIt end, contiguous_iterator<Value, Iterator, n, b, e, v> out ) const
+    {
+        using difference_type = typename std::iterator_traits<InputIt>::difference_type;
+
+        const auto count = std::distance( beg, end );
+        const auto chunk = m_policy->chunk_size( b / 8 );
+        parallel_for_chunks( *m_policy, size_t( count ), chunk, [=]( size_t offset, size_t size ) {
+            write_contiguous( std::next( beg, offset ), difference_type( size ), std::next( out, offset ) );
+        } );
+        return std::next( out, count );
+    }
+};
+
+// calls f( pos, n ) for the n > 0 samples at pos of each segment touched by [beg, end)
+template <class Value, class Format, class Char, class F>
+void for_each_segment( segmented_iterator<Value, Format, Char> beg, segmented_iterator<Value, Format, Char> end, F f )
+{
+    const auto bytes = beg.bytes_per_sample();
+
+    auto segment = beg.current_segment();
+    auto pos     = beg.pos();
+    for ( ; segment != end.current_segment(); pos = ++segment != beg.last_segment() ? segment->data : nullptr )
+    {
+        if ( const auto n = size_t( segment->data + segment->size - pos ) / bytes )
+            f( pos, n );
+    }
+
+    if ( pos != end.pos() )
+        f( pos, size_t( end.pos() - pos ) / bytes );
+}
+
+// segmented pcm -> contiguous values, one kernel call per segment
+template <class Value, class Format, class Char, class OutputIt>
+OutputIt segmented_copy( segmented_iterator<Value, Format, Char> beg,
+                         segmented_iterator<Value, Format, Char> end,
+                         OutputIt                                out,
+                         std::true_type /*is_contiguous*/ )
+{
+    const auto read   = read_kernel<Value>( beg.format() );
+    size_t     offset = 0;
+    for_each_segment( beg, end, [&]( const char* src, size_t n ) {
+        read( src, n, to_address( std::next( out, offset ) ) );
+        offset += n;
+    } );
+    return std::next( out, offset );
+}
+
+template <class Value, class Format, class Char, class OutputIt>
+OutputIt segmented_copy( segmented_iterator<Value, Format, Char> beg,
+                         segmented_iterator<Value, Format, Char> end,
+                         OutputIt                                out,
+                         std::false_type /*is_contiguous*/ )
+{
+    const auto bytes = beg.bytes_per_sample();
+    for_each_segment( beg, end, [&]( Char* src, size_t n ) {
+        out = dispatch( copy_impl{},
+                        ::pcm::make_iterator<Value>( src, beg.format() ),
+                        ::pcm::make_iterator<Value>( src + n * bytes, beg.format() ),
+                        out );
+    } );
+    return out;
+}
+
+template <class InputIt, class Value, class Format>
+void write_segment( InputIt beg, size_t n, char* dst, const Format&, write_kernel_t<Value> write, std::true_type )
+{
+    write( to_address( beg ), n, dst );
+}
+
+template <class InputIt, class Value, class Format>
+void write_segment( InputIt beg, size_t n, char* dst, const Format& fmt, write_kernel_t<Value>, std::false_type )
+{
+    std::copy_n( beg, n, ::pcm::make_iterator<Value>( dst, fmt ) );
+}
+
+// values -> segmented pcm, the segments must have room for all values
+template <class InputIt, class Value, class Format>
+auto segmented_copy( InputIt beg, InputIt end, segmented_iterator<Value, Format, char> out )
+{
+    using is_contiguous = is_contiguous_value_iterator<InputIt, Value>;
+
+    const auto bytes = out.bytes_per_sample();
+    const auto last  = out.last_segment();
+    const auto write = write_kernel<Value>( out.format() );
+
+    auto remaining = size_t( std::distance( beg, end ) );
+    auto segment   = out.current_segment();
+    auto pos       = out.pos();
+    for ( ; remaining > 0 && segment != last; pos = ++segment != last ? segment->data : nullptr )
+    {
+        const auto n = std::min( remaining, size_t( segment->data + segment->size - pos ) / bytes );
+        if ( n == 0 )
+            continue;
+
+        write_segment<InputIt, Value>( beg, n, pos, out.format(), write, is_contiguous{} );
+
+        std::advance( beg, n );
+        remaining -= n;
+        pos += n * bytes;
+
+        if ( pos != segment->data + segment->size )
+            break;
+    }
+
+    assert( remaining == 0 );
+    return segmented_iterator<Value, Format, char>( segment, last, pos, out.format() );
+}
+
 } // namespace detail
 
 // iterator based
@@ -64,6 +355,36 @@ auto copy( InputIt ibeg, InputIt iend, OutputIt obeg, OutputIt oend )
     return dispatch( detail::copy_impl{}, ibeg, iend, obeg, oend );
 }
 
+// dithers floating point values written to integer formats, d carries the state across calls
+template <class InputIt, class OutputIt>
+auto copy( InputIt beg, InputIt end, OutputIt out, dither& d )
+{
+    return dispatch( detail::dither_copy_impl{&d}, beg, end, out );
+}
+
+// converts segmented pcm data segment by segment
+template <class Value, class Format, class Char, class OutputIt>
+auto copy( segmented_iterator<Value, Format, Char> beg, segmented_iterator<Value, Format, Char> end, OutputIt out )
+{
+    return detail::segmented_copy( beg, end, out, detail::is_contiguous_value_iterator<OutputIt, Value>{} );
+}
+
+template <class InputIt,
+          class Value,
+          class Format,
+          class = std::enable_if_t<!is_segmented_iterator<InputIt>::value>>
+auto copy( InputIt beg, InputIt end, segmented_iterator<Value, Format, char> out )
+{
+    return detail::segmented_copy( beg, end, out );
+}
+
+// converts contiguous pcm data on several threads, see parallel_policy
+template <class InputIt, class OutputIt>
+auto copy( const parallel_policy& policy, InputIt beg, InputIt end, OutputIt out )
+{
+    return dispatch( detail::parallel_copy_impl{&policy}, beg, end, out );
+}
+
 // range based
 template <class InputRange, class OutputIt>
 auto copy( const InputRange& range, OutputIt out )
@@ -71,4 +392,16 @@ auto copy( const InputRange& range, OutputIt out )
     return ::pcm::copy( std::begin( range ), std::end( range ), out );
 }
 
+template <class InputRange, class OutputIt>
+auto copy( const InputRange& range, OutputIt out, dither& d )
+{
+    return ::pcm::copy( std::begin( range ), std::end( range ), out, d );
+}
+
+template <class InputRange, class OutputIt>
+auto copy( const parallel_policy& policy, const InputRange& range, OutputIt out )
+{
+    return ::pcm::copy( policy, std::begin( range ), std::end( range ), out );
+}
+
 } // namespace pcm
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/algorithm/convert.h>
+#include <ni/media/pcm/detail/kernels.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace pcm
+{
+namespace detail
+{
+
+// converts a block of frames into L1 and mixes it from there, so the data is touched once
+template <class Value>
+void copy_transform_impl( read_kernel_t<Value> read,
+                          mix_kernel_t<Value>  mix,
+                          const char*          src,
+                          size_t               bytes,
+                          Value*               dst,
+                          size_t               frames,
+                          size_t               in_channels,
+                          size_t               out_channels,
+                          const Value*         matrix )
+{
+    static_assert( std::is_floating_point<Value>::value, "copy_transform mixes floating point values only" );
+
+    if ( in_channels > planar_block_size )
+    {
+        auto frame = std::vector<Value>( in_channels );
+        for ( size_t f = 0; f < frames; ++f, src += in_channels * bytes, dst += out_channels )
+        {
+            read( src, in_channels, frame.data() );
+            mix( frame.data(), 1, in_channels, out_channels, matrix, dst );
+        }
+        return;
+    }
+
+    const auto block_frames = planar_block_size / in_channels;
+
+    std::array<Value, planar_block_size> block;
+    for ( size_t offset = 0; offset < frames; offset += block_frames )
+    {
+        const auto n = std::min( block_frames, frames - offset );
+        read( src + offset * in_channels * bytes, n * in_channels, block.data() );
+        mix( block.data(), n, in_channels, out_channels, matrix, dst + offset * out_channels );
+    }
+}
+
+} // namespace detail
+
+// converts frames of interleaved pcm data in format fmt and mixes them to frames of out_channels
+// values, dst[out] = sum over in of matrix[out * in_channels + in] * src[in]. Gains are part of
+// the matrix. Mono to stereo, stereo to mono, stereo and 5.1 to stereo have dedicated kernels.
+template <class Value, class Format>
+void copy_transform( const char*   src,
+                     const Format& fmt,
+                     Value*        dst,
+                     size_t        frames,
+                     size_t        in_channels,
+                     size_t        out_channels,
+                     const Value*  matrix )
+{
+    detail::copy_transform_impl( read_kernel<Value>( fmt ),
+                                 detail::mix_kernel<Value>( in_channels, out_channels ),
+                                 src,
+                                 fmt.bitwidth() / 8u,
+                                 dst,
+                                 frames,
+                                 in_channels,
+                                 out_channels,
+                                 matrix );
+}
+
+// converts frames of interleaved pcm data in format fmt and applies one gain per channel
+template <class Value, class Format>
+void copy_transform( const char* src, const Format& fmt, Value* dst, size_t frames, size_t channels, const Value* gains )
+{
+    detail::copy_transform_impl( read_kernel<Value>( fmt ),
+                                 &detail::scalar::scale<Value>,
+                                 src,
+                                 fmt.bitwidth() / 8u,
+                                 dst,
+                                 frames,
+                                 channels,
+                                 channels,
+                                 gains );
+}
+
+} // namespace pcm
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/algorithm/convert.h>
+#include <ni/media/pcm/detail/kernels.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace pcm
+{
+namespace detail
+{
+
+template <class Value>
+void deinterleave_copy_impl(
+    read_kernel_t<Value> read, const char* src, size_t frames, size_t channels, size_t bytes, Value* const* dst )
+{
+    if ( channels == 1 )
+    {
+        read( src, frames, dst[0] );
+        return;
+    }
+
+    if ( channels > planar_block_size )
+    {
+        for ( size_t f = 0; f < frames; ++f )
+            for ( size_t c = 0; c < channels; ++c, src += bytes )
+                read( src, 1, dst[c] + f );
+        return;
+    }
+
+    const auto deinterleave = deinterleave_kernel<Value>();
+    const auto block_frames = planar_block_size / channels;
+
+    std::array<Value, planar_block_size> block;
+    for ( size_t offset = 0; offset < frames; offset += block_frames )
+    {
+        const auto n = std::min( block_frames, frames - offset );
+        read( src + offset * channels * bytes, n * channels, block.data() );
+        deinterleave( block.data(), n, channels, dst, offset );
+    }
+}
+
+} // namespace detail
+
+// converts frames of interleaved pcm data in format fmt to one buffer per channel
+template <class Value, class Format>
+void deinterleave_copy( const char* src, size_t frames, size_t channels, const Format& fmt, Value* const* dst )
+{
+    detail::deinterleave_copy_impl( read_kernel<Value>( fmt ), src, frames, channels, fmt.bitwidth() / 8u, dst );
+}
+
+} // namespace pcm
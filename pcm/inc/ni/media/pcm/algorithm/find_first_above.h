@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/reduce.h>
+#include <ni/media/pcm/dispatch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace pcm
+{
+namespace detail
+{
+
+struct find_first_above_impl
+{
+    template <class InputIt, class Value>
+    InputIt operator()( InputIt beg, InputIt end, Value threshold ) const
+    {
+        using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+        return std::find_if( beg, end, [threshold]( value_type value ) { return std::abs( value ) > threshold; } );
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_reduce_t<Value, Iterator>>
+    auto operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> end,
+                     Value                                            threshold ) const
+    {
+        const auto find_above = reduce_kernels<Value>().find_above;
+
+        auto result = end;
+        for_each_block( beg, end, [&]( const Value* block, size_t size, size_t offset ) {
+            const auto index = find_above( block, size, threshold );
+            if ( index == size )
+                return true;
+
+            result = std::next( beg, offset + index );
+            return false;
+        } );
+        return result;
+    }
+};
+
+} // namespace detail
+
+// the first sample with a magnitude above threshold, end if there is none
+template <class InputIt, class Value>
+InputIt find_first_above( InputIt beg, InputIt end, Value threshold )
+{
+    using value_type = typename std::iterator_traits<InputIt>::value_type;
+    return dispatch( detail::find_first_above_impl{}, beg, end, value_type( threshold ) );
+}
+
+template <class InputRange, class Value>
+auto find_first_above( const InputRange& range, Value threshold )
+{
+    return ::pcm::find_first_above( std::begin( range ), std::end( range ), threshold );
+}
+
+} // namespace pcm
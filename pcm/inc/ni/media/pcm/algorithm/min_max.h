@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/reduce.h>
+#include <ni/media/pcm/dispatch.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace pcm
+{
+namespace detail
+{
+
+struct min_max_impl
+{
+    template <class InputIt>
+    auto operator()( InputIt beg, InputIt end ) const
+    {
+        using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+        auto result = std::pair<value_type, value_type>();
+        if ( beg == end )
+            return result;
+
+        result.first = result.second = *beg;
+        for ( ++beg; beg != end; ++beg )
+        {
+            const value_type value = *beg;
+            result.first           = std::min( result.first, value );
+            result.second          = std::max( result.second, value );
+        }
+        return result;
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_reduce_t<Value, Iterator>>
+    auto operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> end ) const
+    {
+        if ( beg == end )
+            return std::pair<Value, Value>();
+
+        const auto min_max = reduce_kernels<Value>().min_max;
+
+        auto result = std::make_pair( std::numeric_limits<Value>::max(), std::numeric_limits<Value>::lowest() );
+        for_each_block( beg, end, [&]( const Value* block, size_t size, size_t ) {
+            result = min_max( block, size, result );
+            return true;
+        } );
+        return result;
+    }
+};
+
+} // namespace detail
+
+// the smallest and the largest sample, a pair of zeros for an empty range
+template <class InputIt>
+auto min_max( InputIt beg, InputIt end )
+{
+    return dispatch( detail::min_max_impl{}, beg, end );
+}
+
+template <class InputRange>
+auto min_max( const InputRange& range )
+{
+    return ::pcm::min_max( std::begin( range ), std::end( range ) );
+}
+
+} // namespace pcm
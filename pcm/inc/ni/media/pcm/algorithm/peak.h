@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/reduce.h>
+#include <ni/media/pcm/dispatch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace pcm
+{
+namespace detail
+{
+
+struct peak_impl
+{
+    template <class InputIt>
+    auto operator()( InputIt beg, InputIt end ) const
+    {
+        using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+        auto result = value_type();
+        for ( ; beg != end; ++beg )
+            result = std::max( result, value_type( std::abs( value_type( *beg ) ) ) );
+        return result;
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_reduce_t<Value, Iterator>>
+    auto operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> end ) const
+    {
+        const auto peak = reduce_kernels<Value>().peak;
+
+        auto result = Value();
+        for_each_block( beg, end, [&]( const Value* block, size_t size, size_t ) {
+            result = peak( block, size, result );
+            return true;
+        } );
+        return result;
+    }
+};
+
+} // namespace detail
+
+// the largest magnitude of all samples, zero for an empty range
+template <class InputIt>
+auto peak( InputIt beg, InputIt end )
+{
+    return dispatch( detail::peak_impl{}, beg, end );
+}
+
+template <class InputRange>
+auto peak( const InputRange& range )
+{
+    return ::pcm::peak( std::begin( range ), std::end( range ) );
+}
+
+} // namespace pcm
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/reduce.h>
+#include <ni/media/pcm/dispatch.h>
+
+#include <cmath>
+#include <iterator>
+
+namespace pcm
+{
+namespace detail
+{
+
+struct sum_of_squares_impl
+{
+    template <class InputIt>
+    auto operator()( InputIt beg, InputIt end ) const
+    {
+        using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+        double result = 0;
+        for ( ; beg != end; ++beg )
+        {
+            const auto value = double( value_type( *beg ) );
+            result += value * value;
+        }
+        return value_type( result );
+    }
+
+    template <class Value,
+              class Iterator,
+              number_type   n,
+              bitwidth_type b,
+              endian_type   e,
+              bitwidth_type v,
+              class = enable_if_contiguous_reduce_t<Value, Iterator>>
+    auto operator()( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> end ) const
+    {
+        const auto sum_of_squares = reduce_kernels<Value>().sum_of_squares;
+
+        double result = 0;
+        for_each_block( beg, end, [&]( const Value* block, size_t size, size_t ) {
+            result = sum_of_squares( block, size, result );
+            return true;
+        } );
+        return Value( result );
+    }
+};
+
+} // namespace detail
+
+// the sum of all squared samples, accumulated in double
+template <class InputIt>
+auto sum_of_squares( InputIt beg, InputIt end )
+{
+    return dispatch( detail::sum_of_squares_impl{}, beg, end );
+}
+
+template <class InputRange>
+auto sum_of_squares( const InputRange& range )
+{
+    return ::pcm::sum_of_squares( std::begin( range ), std::end( range ) );
+}
+
+// the root mean square of all samples, zero for an empty range
+template <class InputIt>
+auto rms( InputIt beg, InputIt end )
+{
+    using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+    const auto count = std::distance( beg, end );
+    return count > 0 ? value_type( std::sqrt( double( ::pcm::sum_of_squares( beg, end ) ) / double( count ) ) )
+                     : value_type();
+}
+
+template <class InputRange>
+auto rms( const InputRange& range )
+{
+    return ::pcm::rms( std::begin( range ), std::end( range ) );
+}
+
+} // namespace pcm
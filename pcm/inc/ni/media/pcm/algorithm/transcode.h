@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/compiletime_format.h>
+#include <ni/media/pcm/detail/kernels.h>
+#include <ni/media/pcm/runtime_format.h>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+
+namespace pcm
+{
+
+// A transcode kernel converts n samples from one pcm format to another without going through a value type.
+// Integer to integer conversions are exact (byte swaps, sign flips, widening and narrowing shifts),
+// floating point is only involved if one of the formats is floating point.
+
+using transcode_kernel_t = detail::transcode_kernel_t;
+
+namespace detail
+{
+
+template <class Source, class... Ts>
+auto make_transcode_kernels( const std::tuple<Ts...>& ) -> std::array<transcode_kernel_t, sizeof...( Ts )>
+{
+    return {{&transcode<Source, Ts>...}};
+}
+
+template <class... Ts>
+auto make_transcode_table( const std::tuple<Ts...>& tags )
+    -> std::array<std::array<transcode_kernel_t, sizeof...( Ts )>, sizeof...( Ts )>
+{
+    return {{make_transcode_kernels<Ts>( tags )...}};
+}
+
+} // namespace detail
+
+template <number_type sn, bitwidth_type sb, endian_type se, number_type tn, bitwidth_type tb, endian_type te>
+auto transcode_kernel( const compiletime_format<sn, sb, se>&, const compiletime_format<tn, tb, te>& )
+    -> transcode_kernel_t
+{
+    return &detail::transcode<compiletime_format<sn, sb, se>, compiletime_format<tn, tb, te>>;
+}
+
+inline auto transcode_kernel( const runtime_format& src_fmt, const runtime_format& dst_fmt ) -> transcode_kernel_t
+{
+    static const auto kernels = detail::make_transcode_table( compiletime_formats() );
+    return kernels.at( src_fmt.index() ).at( dst_fmt.index() );
+}
+
+// converts n samples of pcm data in format src_fmt starting at src to format dst_fmt starting at dst
+template <class SourceFormat, class TargetFormat>
+void transcode( const char* src, const SourceFormat& src_fmt, char* dst, const TargetFormat& dst_fmt, std::size_t n )
+{
+    transcode_kernel( src_fmt, dst_fmt )( src, n, dst );
+}
+
+} // namespace pcm
@@ -31,7 +31,9 @@
 namespace pcm
 {
 
-template <number_type n = signed_integer, bitwidth_type b = _8bit, endian_type e = native_endian>
+// Formats with fewer valid bits than their container ( 24 bit in 32 bit ) keep the sample in the
+// upper bits of the container, the padding bits below are zero.
+template <number_type n = signed_integer, bitwidth_type b = _8bit, endian_type e = native_endian, bitwidth_type v = b>
 struct compiletime_format
 {
     constexpr compiletime_format()                            = default;
@@ -51,27 +53,50 @@ struct compiletime_format
     {
         return e;
     }
+
+    constexpr auto valid_bits() const
+    {
+        return v;
+    }
 };
 
-template <number_type ln, bitwidth_type lb, endian_type le, number_type rn, bitwidth_type rb, endian_type re>
-constexpr auto operator==( compiletime_format<ln, lb, le>, compiletime_format<rn, rb, re> )
+template <number_type   ln,
+          bitwidth_type lb,
+          endian_type   le,
+          bitwidth_type lv,
+          number_type   rn,
+          bitwidth_type rb,
+          endian_type   re,
+          bitwidth_type rv>
+constexpr auto operator==( compiletime_format<ln, lb, le, lv>, compiletime_format<rn, rb, re, rv> )
 {
-    return std::is_same<compiletime_format<ln, lb, le>, compiletime_format<rn, rb, re>>::value;
+    return std::is_same<compiletime_format<ln, lb, le, lv>, compiletime_format<rn, rb, re, rv>>::value;
 }
 
-template <number_type ln, bitwidth_type lb, endian_type le, number_type rn, bitwidth_type rb, endian_type re>
-constexpr auto operator!=( compiletime_format<ln, lb, le>, compiletime_format<rn, rb, re> )
+template <number_type   ln,
+          bitwidth_type lb,
+          endian_type   le,
+          bitwidth_type lv,
+          number_type   rn,
+          bitwidth_type rb,
+          endian_type   re,
+          bitwidth_type rv>
+constexpr auto operator!=( compiletime_format<ln, lb, le, lv>, compiletime_format<rn, rb, re, rv> )
 {
-    return !std::is_same<compiletime_format<ln, lb, le>, compiletime_format<rn, rb, re>>::value;
+    return !std::is_same<compiletime_format<ln, lb, le, lv>, compiletime_format<rn, rb, re, rv>>::value;
 }
 
-template <number_type n, bitwidth_type b, endian_type e>
-constexpr std::ostream& operator<<( std::ostream& stream, compiletime_format<n, b, e> fmt )
+template <number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+std::ostream& operator<<( std::ostream& stream, compiletime_format<n, b, e, v> fmt )
 {
-    constexpr auto number   = fmt.number() == floating_point ? "f" : fmt.number() == signed_integer ? "s" : "u";
-    constexpr auto bitwidth = fmt.bitwidth();
+    constexpr auto number   = to_string( fmt.number() );
+    constexpr auto bitwidth = static_cast<uint32_t>( fmt.bitwidth() );
+    constexpr auto valid    = static_cast<uint32_t>( fmt.valid_bits() );
     constexpr auto endian   = fmt.endian() == big_endian ? "be" : "le";
 
+    if ( valid != bitwidth )
+        return stream << number << valid << "in" << bitwidth << endian;
+
     return stream << number << bitwidth << endian;
 }
 
@@ -100,7 +125,19 @@ inline constexpr auto compiletime_formats()
                       compiletime_format<floating_point, _32bit, big_endian>,
                       compiletime_format<floating_point, _32bit, little_endian>,
                       compiletime_format<floating_point, _64bit, big_endian>,
-                      compiletime_format<floating_point, _64bit, little_endian>>();
+                      compiletime_format<floating_point, _64bit, little_endian>,
+                      compiletime_format<alaw, _8bit, big_endian>,
+                      compiletime_format<alaw, _8bit, little_endian>,
+                      compiletime_format<ulaw, _8bit, big_endian>,
+                      compiletime_format<ulaw, _8bit, little_endian>,
+                      compiletime_format<signed_integer, _16bit, big_endian, _12bit>,
+                      compiletime_format<signed_integer, _16bit, little_endian, _12bit>,
+                      compiletime_format<signed_integer, _24bit, big_endian, _20bit>,
+                      compiletime_format<signed_integer, _24bit, little_endian, _20bit>,
+                      compiletime_format<signed_integer, _32bit, big_endian, _24bit>,
+                      compiletime_format<signed_integer, _32bit, little_endian, _24bit>,
+                      compiletime_format<floating_point, _16bit, big_endian>,
+                      compiletime_format<floating_point, _16bit, little_endian>>();
 }
 
 
@@ -24,8 +24,12 @@
 
 #include "runtime_format.h"
 
+#include <ni/media/pcm/detail/companding.h>
+#include <ni/media/pcm/detail/half.h>
+
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <iterator>
 #include <type_traits>
@@ -52,10 +56,11 @@ Target sign_cast( Source val,
     return static_cast<Target>( val ^ mask );
 }
 
+// round half away from zero, branchless: val - 0.5 == val + copysign( 0.5, val ) for negative val
 template <typename Integer, typename Real>
 Integer round_cast( Real val )
 {
-    return static_cast<Integer>( val > 0 ? val + Real{0.5} : val - Real{0.5} );
+    return static_cast<Integer>( val + std::copysign( Real{0.5}, val ) );
 }
 
 template <typename T1, typename T2>
@@ -137,6 +142,13 @@ struct storage
 {
 };
 
+// half floats are converted as the float they code
+template <endian_type e>
+struct storage<::pcm::compiletime_format<::pcm::floating_point, ::pcm::_16bit, e>>
+{
+    using type = float;
+};
+
 template <endian_type e>
 struct storage<::pcm::compiletime_format<::pcm::floating_point, ::pcm::_32bit, e>>
 {
@@ -209,6 +221,49 @@ struct storage<::pcm::compiletime_format<::pcm::unsigned_integer, ::pcm::_64bit,
     using type = uint64_t;
 };
 
+// companded samples are converted as the 16 bit linear samples they code
+template <endian_type e>
+struct storage<::pcm::compiletime_format<::pcm::alaw, ::pcm::_8bit, e>>
+{
+    using type = int16_t;
+};
+
+template <endian_type e>
+struct storage<::pcm::compiletime_format<::pcm::ulaw, ::pcm::_8bit, e>>
+{
+    using type = int16_t;
+};
+
+// padded samples are converted as their container
+template <number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+struct storage<::pcm::compiletime_format<n, b, e, v>> : storage<::pcm::compiletime_format<n, b, e>>
+{
+};
+
+template <typename Format>
+using is_padded = std::integral_constant<bool, ( Format{}.valid_bits() < Format{}.bitwidth() )>;
+
+template <typename Format, typename Value>
+Value clear_padding( Value val, std::false_type )
+{
+    return val;
+}
+
+// the valid bits sit in the upper bits of the storage value, writing truncates like packed 24 bit does
+template <typename Format, typename Value>
+Value clear_padding( Value val, std::true_type )
+{
+    static constexpr auto mask = static_cast<Value>( ~uint64_t{0} << ( 8 * sizeof( Value ) - Format{}.valid_bits() ) );
+
+    return static_cast<Value>( val & mask );
+}
+
+template <typename Format, typename Value>
+Value clear_padding( Value val )
+{
+    return clear_padding<Format>( val, is_padded<Format>{} );
+}
+
 // equivalent of std::copy_n with the additional garanty that iterators will be incremented exactly n times
 template <typename InputIterator, typename Size, typename OutputIterator>
 OutputIterator increment_n_copy_n( InputIterator in, Size size, OutputIterator out )
@@ -218,7 +273,7 @@ OutputIterator increment_n_copy_n( InputIterator in, Size size, OutputIterator o
     return out;
 }
 
-template <typename Format>
+template <typename Format, bool = is_companded<Format{}.number()>::value, bool = is_half<Format>::value>
 struct intermediate
 {
     using value_type = typename storage<Format>::type;
@@ -235,7 +290,7 @@ struct intermediate
     }
 
     intermediate( value_type val )
-    : m_value( val )
+    : m_value( clear_padding<Format>( val ) )
     {
     }
 
@@ -269,13 +324,124 @@ struct intermediate
 
     auto value() const -> value_type
     {
-        return m_value;
+        return clear_padding<Format>( m_value );
     }
 
 private:
     value_type m_value = 0;
 };
 
+// holds the 8 bit code, value() decodes it
+template <typename Format>
+struct intermediate<Format, true, false>
+{
+    using value_type     = int16_t;
+    using number         = number_t<Format{}.number()>;
+    using iterator       = char*;
+    using const_iterator = const char*;
+
+    template <typename InputIterator>
+    intermediate( InputIterator iter )
+    : m_code( static_cast<char>( *iter ) )
+    {
+    }
+
+    intermediate( value_type val )
+    : m_code( static_cast<char>( g711::encode( val, number{} ) ) )
+    {
+    }
+
+    auto begin() -> iterator
+    {
+        return &m_code;
+    }
+
+    auto end() -> iterator
+    {
+        return &m_code + 1;
+    }
+
+    auto begin() const -> const_iterator
+    {
+        return &m_code;
+    }
+
+    auto end() const -> const_iterator
+    {
+        return &m_code + 1;
+    }
+
+    auto size() const -> size_t
+    {
+        return 1;
+    }
+
+    auto value() const -> value_type
+    {
+        return g711::decode( static_cast<uint8_t>( m_code ), number{} );
+    }
+
+private:
+    char m_code = 0;
+};
+
+// holds the 16 bit half float in native byte order, value() decodes it
+template <typename Format>
+struct intermediate<Format, false, true>
+{
+    using value_type = float;
+
+    static constexpr auto is_native_endian = Format{}.endian() == native_endian;
+    static constexpr auto num_bytes        = sizeof( uint16_t );
+
+    template <typename InputIterator>
+    intermediate( InputIterator iter )
+    {
+        increment_n_copy_n( iter, num_bytes, begin() );
+    }
+
+    intermediate( value_type val )
+    : m_half( binary16::encode( val ) )
+    {
+    }
+
+    using iterator       = std::conditional_t<is_native_endian, char*, std::reverse_iterator<char*>>;
+    using const_iterator = std::conditional_t<is_native_endian, const char*, std::reverse_iterator<const char*>>;
+
+    auto begin() -> iterator
+    {
+        return iterator( reinterpret_cast<char*>( &m_half ) + ( is_native_endian ? 0 : num_bytes ) );
+    }
+
+    auto end() -> iterator
+    {
+        return begin() + size();
+    }
+
+    auto begin() const -> const_iterator
+    {
+        return const_iterator( reinterpret_cast<const char*>( &m_half ) + ( is_native_endian ? 0 : num_bytes ) );
+    }
+
+    auto end() const -> const_iterator
+    {
+        return begin() + size();
+    }
+
+    auto size() const -> size_t
+    {
+        return num_bytes;
+    }
+
+    auto value() const -> value_type
+    {
+        return binary16::decode( m_half );
+    }
+
+private:
+    uint16_t m_half = 0;
+};
+
 template <typename Value, typename Iterator, typename Format>
 Value read_impl( Iterator iter )
 {
@@ -304,10 +470,10 @@ auto make_write_impls( const std::tuple<Ts...>& ) -> std::array<void ( * )( Iter
 
 } // namespace detail
 
-template <typename Value, typename Iterator, number_type n, bitwidth_type b, endian_type e>
-Value read( Iterator iter, const compiletime_format<n, b, e>& )
+template <typename Value, typename Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+Value read( Iterator iter, const compiletime_format<n, b, e, v>& )
 {
-    return detail::read_impl<Value, Iterator, compiletime_format<n, b, e>>( iter );
+    return detail::read_impl<Value, Iterator, compiletime_format<n, b, e, v>>( iter );
 }
 
 template <typename Value, typename Iterator>
@@ -317,10 +483,10 @@ Value read( Iterator iter, const runtime_format& fmt )
     return impls.at( fmt.index() )( iter );
 }
 
-template <typename Value, typename Iterator, number_type n, bitwidth_type b, endian_type e>
-void write( Iterator iter, Value val, const compiletime_format<n, b, e>& )
+template <typename Value, typename Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+void write( Iterator iter, Value val, const compiletime_format<n, b, e, v>& )
 {
-    detail::write_impl<Value, Iterator, compiletime_format<n, b, e>>( iter, val );
+    detail::write_impl<Value, Iterator, compiletime_format<n, b, e, v>>( iter, val );
 }
 
 template <typename Value, typename Iterator>
@@ -33,13 +33,18 @@ enum number_type : uint8_t
 {
     signed_integer = 0,
     unsigned_integer,
-    floating_point
+    floating_point,
+    alaw, // G.711 companded 8 bit
+    ulaw,
 };
 
+// container widths, 12 and 20 bit only occur as valid bits of a wider container
 enum bitwidth_type : uint8_t
 {
     _8bit  = 8,
+    _12bit = 12,
     _16bit = 16,
+    _20bit = 20,
     _24bit = 24,
     _32bit = 32,
     _64bit = 64
@@ -58,4 +63,14 @@ enum endian_type : uint8_t
 #endif
 };
 
+// the number part of format strings like "s16le", "a8le" or "m8le"
+constexpr auto to_string( number_type n )
+{
+    return n == floating_point     ? "f"
+           : n == signed_integer   ? "s"
+           : n == unsigned_integer ? "u"
+           : n == alaw             ? "a"
+                                   : "m";
+}
+
 } // namespace pcm
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/description.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+// G.711 A-law and mu-law companding. Both code 8 bit samples as sign, 3 bit segment and 4 bit mantissa,
+// the linear side is a 16 bit sample. Encoding truncates within a segment like the reference implementation.
+
+template <number_type n>
+using number_t = std::integral_constant<number_type, n>;
+
+template <number_type n>
+using is_companded = std::integral_constant<bool, n == alaw || n == ulaw>;
+
+namespace g711
+{
+
+constexpr int quant_mask = 0x0f;
+constexpr int seg_mask   = 0x70;
+constexpr int seg_shift  = 4;
+constexpr int sign_bit   = 0x80;
+
+// mu-law bias and clip in 14 bit units
+constexpr int ulaw_bias = 0x84;
+constexpr int ulaw_clip = 8159;
+
+// upper ends of the segments in 13 bit (A-law) and 14 bit (mu-law) units
+constexpr int16_t alaw_segment_ends[8] = {0x1f, 0x3f, 0x7f, 0xff, 0x1ff, 0x3ff, 0x7ff, 0xfff};
+constexpr int16_t ulaw_segment_ends[8] = {0x3f, 0x7f, 0xff, 0x1ff, 0x3ff, 0x7ff, 0xfff, 0x1fff};
+
+// The decoded magnitude has at most 5 significant bits, so segment and mantissa of a code are the
+// exponent and the upper mantissa bits of a float in [-1, 1). These are the remaining bits for
+// segment 0 and mantissa 0, A-law segment 0 decodes as segment 1 minus 256, mu-law subtracts its bias.
+constexpr int32_t float_bits = ( 119 << 23 ) | ( 1 << 18 );
+
+inline auto segment( int val, const int16_t* ends ) -> int
+{
+    int seg = 0;
+    while ( seg < 8 && val > ends[seg] )
+        ++seg;
+    return seg;
+}
+
+inline auto decode( uint8_t code, number_t<alaw> ) -> int16_t
+{
+    code ^= 0x55;
+
+    const int seg = ( code & seg_mask ) >> seg_shift;
+    int       t   = ( code & quant_mask ) << 4;
+
+    if ( seg == 0 )
+        t += 8;
+    else
+        t = ( t + 0x108 ) << ( seg - 1 );
+
+    return int16_t( ( code & sign_bit ) ? t : -t );
+}
+
+inline auto encode( int16_t sample, number_t<alaw> ) -> uint8_t
+{
+    int val  = sample >> 3;
+    int mask = 0xd5;
+    if ( val < 0 )
+    {
+        mask = 0x55;
+        val  = -val - 1;
+    }
+
+    const int seg  = segment( val, alaw_segment_ends );
+    const int code = ( seg << seg_shift ) | ( ( val >> ( seg < 2 ? 1 : seg ) ) & quant_mask );
+    return uint8_t( code ^ mask );
+}
+
+inline auto decode( uint8_t code, number_t<ulaw> ) -> int16_t
+{
+    code = uint8_t( ~code );
+
+    int t = ( ( code & quant_mask ) << 3 ) + ulaw_bias;
+    t <<= ( code & seg_mask ) >> seg_shift;
+
+    return int16_t( ( code & sign_bit ) ? ( ulaw_bias - t ) : ( t - ulaw_bias ) );
+}
+
+inline auto encode( int16_t sample, number_t<ulaw> ) -> uint8_t
+{
+    int val  = sample >> 2;
+    int mask = 0xff;
+    if ( val < 0 )
+    {
+        mask = 0x7f;
+        val  = -val;
+    }
+
+    val = ( val > ulaw_clip ? ulaw_clip : val ) + ( ulaw_bias >> 2 );
+
+    const int seg = segment( val, ulaw_segment_ends );
+    if ( seg >= 8 )
+        return uint8_t( 0x7f ^ mask );
+
+    return uint8_t( ( ( seg << seg_shift ) | ( ( val >> ( seg + 1 ) ) & quant_mask ) ) ^ mask );
+}
+
+} // namespace g711
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/iterator.h>
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pcm
+{
+namespace detail
+{
+
+template <class Iterator, class Value = typename std::iterator_traits<Iterator>::value_type, class = void>
+struct is_contiguous_iterator : std::false_type
+{
+};
+
+template <class T, class Value>
+struct is_contiguous_iterator<T*, Value, void> : std::true_type
+{
+};
+
+// only instantiate std::vector for element types it supports
+template <class Value>
+using contiguous_element_t = std::conditional_t<std::is_arithmetic<Value>::value && !std::is_same<Value, bool>::value, //
+                                                Value,
+                                                char>;
+
+template <class Iterator, class Value>
+struct is_contiguous_iterator<
+    Iterator,
+    Value,
+    std::enable_if_t<!std::is_pointer<Iterator>::value
+                     && std::is_same<Value, contiguous_element_t<Value>>::value
+                     && ( std::is_same<Iterator, typename std::vector<contiguous_element_t<Value>>::iterator>::value
+                          || std::is_same<Iterator, typename std::vector<contiguous_element_t<Value>>::const_iterator>::value
+                          || std::is_same<Iterator, std::string::iterator>::value
+                          || std::is_same<Iterator, std::string::const_iterator>::value )>> : std::true_type
+{
+};
+
+// a contiguous range of raw pcm bytes
+template <class Iterator>
+using is_contiguous_byte_iterator =
+    std::integral_constant<bool,
+                           is_contiguous_iterator<Iterator>::value
+                               && std::is_integral<typename std::iterator_traits<Iterator>::value_type>::value
+                               && sizeof( typename std::iterator_traits<Iterator>::value_type ) == 1>;
+
+// a contiguous range of samples of type Value
+template <class Iterator, class Value>
+using is_contiguous_value_iterator =
+    std::integral_constant<bool,
+                           is_contiguous_iterator<Iterator>::value
+                               && std::is_same<typename std::iterator_traits<Iterator>::value_type, Value>::value>;
+
+// a pcm iterator with a compiletime format
+template <class Value, class Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v>
+using contiguous_iterator = iterator<Value, Iterator, compiletime_format<n, b, e, v>, std::random_access_iterator_tag>;
+
+// must not be called on past-the-end iterators of class type
+template <class Iterator>
+auto to_address( Iterator it )
+{
+    return std::addressof( *it );
+}
+
+template <class T>
+auto to_address( T* ptr )
+{
+    return ptr;
+}
+
+} // namespace detail
+} // namespace pcm
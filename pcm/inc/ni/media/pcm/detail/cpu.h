@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef NIMEDIA_PCM_ENABLE_SIMD
+#define NIMEDIA_PCM_ENABLE_SIMD 1
+#endif
+
+#if NIMEDIA_PCM_ENABLE_SIMD && ( defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 ) )
+#define NIMEDIA_PCM_SIMD_X86 1
+#else
+#define NIMEDIA_PCM_SIMD_X86 0
+#endif
+
+#if NIMEDIA_PCM_ENABLE_SIMD && ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) )
+#define NIMEDIA_PCM_SIMD_NEON 1
+#else
+#define NIMEDIA_PCM_SIMD_NEON 0
+#endif
+
+// enables an instruction set for a single function, so that kernels for several
+// instruction sets can live in the same translation unit and be selected at runtime.
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#define NIMEDIA_PCM_TARGET( isa )
+#else
+#define NIMEDIA_PCM_TARGET( isa ) __attribute__( ( target( isa ) ) )
+#endif
+
+#define NIMEDIA_PCM_TARGET_SSE2 NIMEDIA_PCM_TARGET( "sse2" )
+#define NIMEDIA_PCM_TARGET_AVX2 NIMEDIA_PCM_TARGET( "avx2,f16c" )
+#define NIMEDIA_PCM_TARGET_AVX512 NIMEDIA_PCM_TARGET( "avx512f,avx512bw" )
+
+#if NIMEDIA_PCM_SIMD_X86
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace pcm
+{
+namespace detail
+{
+
+enum class simd_level : uint8_t
+{
+    none = 0,
+    sse2,
+    avx2,
+    avx512,
+    neon,
+};
+
+#if NIMEDIA_PCM_SIMD_X86
+
+inline void cpuid( uint32_t leaf, uint32_t subleaf, uint32_t ( &regs )[4] )
+{
+#if defined( _MSC_VER )
+    int r[4];
+    __cpuidex( r, int( leaf ), int( subleaf ) );
+    for ( auto i = 0; i < 4; ++i )
+        regs[i] = uint32_t( r[i] );
+#else
+    __cpuid_count( leaf, subleaf, regs[0], regs[1], regs[2], regs[3] );
+#endif
+}
+
+inline uint64_t xgetbv()
+{
+#if defined( _MSC_VER )
+    return _xgetbv( 0 );
+#else
+    uint32_t eax = 0, edx = 0;
+    __asm__ volatile( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+    return ( uint64_t( edx ) << 32 ) | eax;
+#endif
+}
+
+inline simd_level detect_simd_level()
+{
+    uint32_t regs[4] = {};
+
+    cpuid( 0, 0, regs );
+    const auto max_leaf = regs[0];
+
+    cpuid( 1, 0, regs );
+    const bool sse2    = ( regs[3] & ( 1u << 26 ) ) != 0;
+    const bool osxsave = ( regs[2] & ( 1u << 27 ) ) != 0;
+    const bool avx     = ( regs[2] & ( 1u << 28 ) ) != 0;
+    const bool f16c    = ( regs[2] & ( 1u << 29 ) ) != 0;
+
+    if ( !sse2 )
+        return simd_level::none;
+
+    // the os has to save the ymm / zmm registers on context switches
+    if ( !osxsave || !avx || max_leaf < 7 )
+        return simd_level::sse2;
+
+    const auto xcr0 = xgetbv();
+    if ( ( xcr0 & 0x6 ) != 0x6 )
+        return simd_level::sse2;
+
+    cpuid( 7, 0, regs );
+    const bool avx2     = ( regs[1] & ( 1u << 5 ) ) != 0;
+    const bool avx512f  = ( regs[1] & ( 1u << 16 ) ) != 0;
+    const bool avx512bw = ( regs[1] & ( 1u << 30 ) ) != 0;
+
+    // every avx2 cpu has f16c, the avx2 kernels rely on it for half floats
+    if ( !avx2 || !f16c )
+        return simd_level::sse2;
+
+    if ( avx512f && avx512bw && ( xcr0 & 0xe6 ) == 0xe6 )
+        return simd_level::avx512;
+
+    return simd_level::avx2;
+}
+
+#elif NIMEDIA_PCM_SIMD_NEON
+
+inline simd_level detect_simd_level()
+{
+    return simd_level::neon;
+}
+
+#else
+
+inline simd_level detect_simd_level()
+{
+    return simd_level::none;
+}
+
+#endif
+
+// the highest instruction set supported by the cpu we are running on
+inline simd_level supported_simd_level()
+{
+    static const auto level = detect_simd_level();
+    return level;
+}
+
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+#include <ni/media/pcm/description.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+// IEEE 754 binary16 half floats, converted as the float they code. Encoding rounds to nearest even and
+// overflows to infinity, NaNs are quieted and keep the upper bits of their payload. This is what F16C
+// (vcvtps2ph / vcvtph2ps) and the NEON conversions do, so the scalar and vectorized kernels agree bitwise.
+
+template <class Format>
+using is_half = std::integral_constant<bool, Format{}.number() == floating_point && Format{}.bitwidth() == _16bit>;
+
+namespace binary16
+{
+
+constexpr uint32_t sign_mask = 0x80000000u;
+
+// float bits of infinity, 2^16 ( the first float that is infinite as half ) and 2^-14 ( the smallest normal half )
+constexpr uint32_t float_infinity = 0xffu << 23;
+constexpr uint32_t float_overflow = ( 127 + 16 ) << 23;
+constexpr uint32_t float_normal   = ( 127 - 14 ) << 23;
+
+// adding 0.5 aligns the 10 mantissa bits of a subnormal half at the bottom of the float mantissa
+constexpr uint32_t subnormal_magic = ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23;
+
+inline auto to_bits( float f ) -> uint32_t
+{
+    uint32_t bits;
+    std::memcpy( &bits, &f, sizeof( bits ) );
+    return bits;
+}
+
+inline auto to_float( uint32_t bits ) -> float
+{
+    float f;
+    std::memcpy( &f, &bits, sizeof( f ) );
+    return f;
+}
+
+inline auto decode( uint16_t half ) -> float
+{
+    constexpr uint32_t exponent_mask = 0x7c00u << 13;
+
+    auto bits = uint32_t( half & 0x7fff ) << 13;
+
+    const auto exponent = bits & exponent_mask;
+    bits += ( 127 - 15 ) << 23;
+
+    if ( exponent == exponent_mask )
+    {
+        // infinity or NaN, the latter is quieted
+        bits += ( 128 - 16 ) << 23;
+        if ( bits & 0x7fffffu )
+            bits |= 0x400000u;
+    }
+    else if ( exponent == 0 )
+    {
+        // zero or subnormal, renormalized by a float subtraction
+        bits = to_bits( to_float( bits + ( 1 << 23 ) ) - to_float( float_normal ) );
+    }
+
+    return to_float( bits | ( uint32_t( half & 0x8000 ) << 16 ) );
+}
+
+inline auto encode( float f ) -> uint16_t
+{
+    auto       bits = to_bits( f );
+    const auto sign = uint16_t( ( bits & sign_mask ) >> 16 );
+    bits &= ~sign_mask;
+
+    if ( bits > float_infinity )
+        return uint16_t( sign | 0x7e00 | ( ( bits >> 13 ) & 0x3ff ) );
+
+    if ( bits >= float_overflow )
+        return uint16_t( sign | 0x7c00 );
+
+    if ( bits < float_normal )
+        return uint16_t( sign | ( to_bits( to_float( bits ) + to_float( subnormal_magic ) ) - subnormal_magic ) );
+
+    // rebias the exponent and round to nearest even, a mantissa carry correctly bumps the exponent
+    const auto odd = ( bits >> 13 ) & 1;
+    bits += ( uint32_t( 15 - 127 ) << 23 ) + 0xfff + odd;
+    return uint16_t( sign | ( bits >> 13 ) );
+}
+
+} // namespace binary16
+} // namespace detail
+} // namespace pcm
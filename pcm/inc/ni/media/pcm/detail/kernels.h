@@ -0,0 +1,450 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/cpu.h>
+#include <ni/media/pcm/detail/kernels/avx2.h>
+#include <ni/media/pcm/detail/kernels/avx512.h>
+#include <ni/media/pcm/detail/kernels/lookup.h>
+#include <ni/media/pcm/detail/kernels/neon.h>
+#include <ni/media/pcm/detail/kernels/scalar.h>
+#include <ni/media/pcm/detail/kernels/sse2.h>
+#include <ni/media/pcm/detail/kernels/transcode.h>
+
+#include <boost/core/ignore_unused.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+template <class Kernels, class Value, class Format>
+auto isa_read_kernel( std::true_type ) -> read_kernel_t<Value>
+{
+    return &Kernels::template read<Value, Format>;
+}
+
+template <class Kernels, class Value, class Format>
+auto isa_read_kernel( std::false_type ) -> read_kernel_t<Value>
+{
+    return nullptr;
+}
+
+template <class Kernels, class Value, class Format>
+auto isa_read_kernel() -> read_kernel_t<Value>
+{
+    return isa_read_kernel<Kernels, Value, Format>( typename Kernels::template can_read<Value, Format>{} );
+}
+
+template <class Kernels, class Value, class Format>
+auto isa_write_kernel( std::true_type ) -> write_kernel_t<Value>
+{
+    return &Kernels::template write<Value, Format>;
+}
+
+template <class Kernels, class Value, class Format>
+auto isa_write_kernel( std::false_type ) -> write_kernel_t<Value>
+{
+    return nullptr;
+}
+
+template <class Kernels, class Value, class Format>
+auto isa_write_kernel() -> write_kernel_t<Value>
+{
+    return isa_write_kernel<Kernels, Value, Format>( typename Kernels::template can_write<Value, Format>{} );
+}
+
+template <class Value, class Format>
+auto fallback_read_kernel( std::true_type /*lookup*/ ) -> read_kernel_t<Value>
+{
+    return &lookup::read<Value, Format>;
+}
+
+template <class Value, class Format>
+auto fallback_read_kernel( std::false_type /*lookup*/ ) -> read_kernel_t<Value>
+{
+    return &scalar::read<Value, Format>;
+}
+
+// the best kernel up to the given instruction set, falls back to a table lookup for 8 and
+// 16 bit formats and to the scalar kernel otherwise
+template <class Value, class Format>
+auto select_read_kernel( simd_level level ) -> read_kernel_t<Value>
+{
+    read_kernel_t<Value> kernel = nullptr;
+
+#if NIMEDIA_PCM_SIMD_X86
+    if ( !kernel && level >= simd_level::avx512 )
+        kernel = isa_read_kernel<avx512::kernels, Value, Format>();
+    if ( !kernel && level >= simd_level::avx2 )
+        kernel = isa_read_kernel<avx2::kernels, Value, Format>();
+    if ( !kernel && level >= simd_level::sse2 )
+        kernel = isa_read_kernel<sse2::kernels, Value, Format>();
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( !kernel && level == simd_level::neon )
+        kernel = isa_read_kernel<neon::kernels, Value, Format>();
+#else
+    boost::ignore_unused( level );
+#endif
+
+    return kernel ? kernel : fallback_read_kernel<Value, Format>( lookup::can_read<Value, Format>{} );
+}
+
+template <class Value, class Format>
+auto select_write_kernel( simd_level level ) -> write_kernel_t<Value>
+{
+    write_kernel_t<Value> kernel = nullptr;
+
+#if NIMEDIA_PCM_SIMD_X86
+    if ( !kernel && level >= simd_level::avx512 )
+        kernel = isa_write_kernel<avx512::kernels, Value, Format>();
+    if ( !kernel && level >= simd_level::avx2 )
+        kernel = isa_write_kernel<avx2::kernels, Value, Format>();
+    if ( !kernel && level >= simd_level::sse2 )
+        kernel = isa_write_kernel<sse2::kernels, Value, Format>();
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( !kernel && level == simd_level::neon )
+        kernel = isa_write_kernel<neon::kernels, Value, Format>();
+#else
+    boost::ignore_unused( level );
+#endif
+
+    return kernel ? kernel : &scalar::write<Value, Format>;
+}
+
+template <class Kernels, class Source, class Target>
+auto isa_byteswap_kernel( std::true_type ) -> transcode_kernel_t
+{
+    return &Kernels::template byteswap<Source, Target>;
+}
+
+template <class Kernels, class Source, class Target>
+auto isa_byteswap_kernel( std::false_type ) -> transcode_kernel_t
+{
+    return nullptr;
+}
+
+template <class Kernels, class Source, class Target>
+auto isa_byteswap_kernel() -> transcode_kernel_t
+{
+    return isa_byteswap_kernel<Kernels, Source, Target>( typename Kernels::template can_byteswap<Source, Target>{} );
+}
+
+// reverses the byte order of each sample, Source and Target only differ in endianness
+template <class Source, class Target>
+auto select_byteswap_kernel( simd_level level ) -> transcode_kernel_t
+{
+    transcode_kernel_t kernel = nullptr;
+
+#if NIMEDIA_PCM_SIMD_X86
+    if ( !kernel && level >= simd_level::avx2 )
+        kernel = isa_byteswap_kernel<avx2::kernels, Source, Target>();
+    if ( !kernel && level >= simd_level::sse2 )
+        kernel = isa_byteswap_kernel<sse2::kernels, Source, Target>();
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( !kernel && level == simd_level::neon )
+        kernel = isa_byteswap_kernel<neon::kernels, Source, Target>();
+#else
+    boost::ignore_unused( level );
+#endif
+
+    return kernel ? kernel : &scalar::byteswap<Source, Target>;
+}
+
+// number of samples staged at once between planar and interleaved data, small enough to stay in L1
+constexpr size_t planar_block_size = 1024;
+
+template <class Value>
+auto select_deinterleave_kernel( simd_level level, std::false_type /*is_float*/ ) -> deinterleave_kernel_t<Value>
+{
+    boost::ignore_unused( level );
+    return &scalar::deinterleave<Value>;
+}
+
+template <class Value>
+auto select_deinterleave_kernel( simd_level level, std::true_type /*is_float*/ ) -> deinterleave_kernel_t<float>
+{
+#if NIMEDIA_PCM_SIMD_X86
+    if ( level >= simd_level::sse2 )
+        return &sse2::deinterleave;
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( level == simd_level::neon )
+        return &neon::deinterleave;
+#endif
+
+    boost::ignore_unused( level );
+    return &scalar::deinterleave<float>;
+}
+
+template <class Value>
+auto select_deinterleave_kernel( simd_level level ) -> deinterleave_kernel_t<Value>
+{
+    return select_deinterleave_kernel<Value>( level, std::is_same<Value, float>{} );
+}
+
+template <class Value>
+auto select_interleave_kernel( simd_level level, std::false_type /*is_float*/ ) -> interleave_kernel_t<Value>
+{
+    boost::ignore_unused( level );
+    return &scalar::interleave<Value>;
+}
+
+template <class Value>
+auto select_interleave_kernel( simd_level level, std::true_type /*is_float*/ ) -> interleave_kernel_t<float>
+{
+#if NIMEDIA_PCM_SIMD_X86
+    if ( level >= simd_level::sse2 )
+        return &sse2::interleave;
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( level == simd_level::neon )
+        return &neon::interleave;
+#endif
+
+    boost::ignore_unused( level );
+    return &scalar::interleave<float>;
+}
+
+template <class Value>
+auto select_interleave_kernel( simd_level level ) -> interleave_kernel_t<Value>
+{
+    return select_interleave_kernel<Value>( level, std::is_same<Value, float>{} );
+}
+
+template <class Value>
+auto select_mix_kernel( simd_level level, size_t in_channels, size_t out_channels, std::false_type /*is_float*/ )
+    -> mix_kernel_t<Value>
+{
+    boost::ignore_unused( level );
+
+    if ( in_channels == 1 && out_channels == 2 )
+        return &scalar::mix_fixed<Value, 1, 2>;
+    if ( in_channels == 2 && out_channels == 1 )
+        return &scalar::mix_fixed<Value, 2, 1>;
+    if ( in_channels == 2 && out_channels == 2 )
+        return &scalar::mix_fixed<Value, 2, 2>;
+    if ( in_channels == 6 && out_channels == 2 )
+        return &scalar::mix_fixed<Value, 6, 2>;
+
+    return &scalar::mix<Value>;
+}
+
+template <class Value>
+auto select_mix_kernel( simd_level level, size_t in_channels, size_t out_channels, std::true_type /*is_float*/ )
+    -> mix_kernel_t<float>
+{
+#if NIMEDIA_PCM_SIMD_X86
+    if ( level >= simd_level::sse2 && in_channels == 1 && out_channels == 2 )
+        return &sse2::mix_1_2;
+    if ( level >= simd_level::sse2 && in_channels == 2 && out_channels == 1 )
+        return &sse2::mix_2_1;
+    if ( level >= simd_level::sse2 && in_channels == 6 && out_channels == 2 )
+        return &sse2::mix_6_2;
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( level == simd_level::neon && in_channels == 1 && out_channels == 2 )
+        return &neon::mix_1_2;
+    if ( level == simd_level::neon && in_channels == 2 && out_channels == 1 )
+        return &neon::mix_2_1;
+#endif
+
+    return select_mix_kernel<float>( level, in_channels, out_channels, std::false_type{} );
+}
+
+// mono to stereo, stereo to mono, stereo and 5.1 to stereo have dedicated kernels
+template <class Value>
+auto select_mix_kernel( simd_level level, size_t in_channels, size_t out_channels ) -> mix_kernel_t<Value>
+{
+    return select_mix_kernel<Value>( level, in_channels, out_channels, std::is_same<Value, float>{} );
+}
+
+template <class Value>
+auto select_reduce_kernels( simd_level level, std::false_type /*is_float*/ ) -> reduce_kernels_t<Value>
+{
+    boost::ignore_unused( level );
+    return {&scalar::min_max<Value>,
+            &scalar::peak<Value>,
+            &scalar::sum<Value>,
+            &scalar::sum_of_squares<Value>,
+            &scalar::find_above<Value>};
+}
+
+template <class Value>
+auto select_reduce_kernels( simd_level level, std::true_type /*is_float*/ ) -> reduce_kernels_t<float>
+{
+    auto kernels = select_reduce_kernels<float>( level, std::false_type{} );
+
+#if NIMEDIA_PCM_SIMD_X86
+    if ( level >= simd_level::sse2 )
+        kernels = {&sse2::min_max, &sse2::peak, &sse2::sum, &sse2::sum_of_squares, &sse2::find_above};
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( level == simd_level::neon )
+    {
+        kernels.min_max    = &neon::min_max;
+        kernels.peak       = &neon::peak;
+        kernels.find_above = &neon::find_above;
+    }
+#endif
+
+    return kernels;
+}
+
+template <class Value>
+auto select_reduce_kernels( simd_level level ) -> reduce_kernels_t<Value>
+{
+    return select_reduce_kernels<Value>( level, std::is_same<Value, float>{} );
+}
+
+template <class Value>
+auto select_dither_kernels( simd_level level, std::false_type /*is_float*/ ) -> dither_kernels_t<Value>
+{
+    boost::ignore_unused( level );
+    return {&scalar::noise<Value>, &scalar::tpdf<Value>};
+}
+
+template <class Value>
+auto select_dither_kernels( simd_level level, std::true_type /*is_float*/ ) -> dither_kernels_t<float>
+{
+#if NIMEDIA_PCM_SIMD_X86
+    if ( level >= simd_level::sse2 )
+        return {&sse2::noise, &sse2::tpdf};
+#elif NIMEDIA_PCM_SIMD_NEON
+    if ( level == simd_level::neon )
+        return {&neon::noise, &neon::tpdf};
+#endif
+
+    return select_dither_kernels<float>( level, std::false_type{} );
+}
+
+template <class Value>
+auto select_dither_kernels( simd_level level ) -> dither_kernels_t<Value>
+{
+    return select_dither_kernels<Value>( level, std::is_same<Value, float>{} );
+}
+
+// the best kernel for the cpu we are running on, selected once
+template <class Value, class Format>
+auto read_kernel() -> read_kernel_t<Value>
+{
+    static const auto kernel = select_read_kernel<Value, Format>( supported_simd_level() );
+    return kernel;
+}
+
+template <class Value, class Format>
+auto write_kernel() -> write_kernel_t<Value>
+{
+    static const auto kernel = select_write_kernel<Value, Format>( supported_simd_level() );
+    return kernel;
+}
+
+template <class Value>
+auto reduce_kernels() -> reduce_kernels_t<Value>
+{
+    static const auto kernels = select_reduce_kernels<Value>( supported_simd_level() );
+    return kernels;
+}
+
+template <class Value>
+auto dither_kernels() -> dither_kernels_t<Value>
+{
+    static const auto kernels = select_dither_kernels<Value>( supported_simd_level() );
+    return kernels;
+}
+
+template <class Value>
+auto mix_kernel( size_t in_channels, size_t out_channels ) -> mix_kernel_t<Value>
+{
+    return select_mix_kernel<Value>( supported_simd_level(), in_channels, out_channels );
+}
+
+template <class Source, class Target>
+auto byteswap_kernel() -> transcode_kernel_t
+{
+    static const auto kernel = select_byteswap_kernel<Source, Target>( supported_simd_level() );
+    return kernel;
+}
+
+template <class Value>
+auto deinterleave_kernel() -> deinterleave_kernel_t<Value>
+{
+    static const auto kernel = select_deinterleave_kernel<Value>( supported_simd_level() );
+    return kernel;
+}
+
+template <class Value>
+auto interleave_kernel() -> interleave_kernel_t<Value>
+{
+    static const auto kernel = select_interleave_kernel<Value>( supported_simd_level() );
+    return kernel;
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst, transcode_path_t<transcode_path::identical> )
+{
+    if ( n > 0 )
+        std::memcpy( dst, src, n * ( Source{}.bitwidth() / 8 ) );
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst, transcode_path_t<transcode_path::byteswap> )
+{
+    byteswap_kernel<Source, Target>()( src, n, dst );
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst, transcode_path_t<transcode_path::to_native_real> )
+{
+    using real_type = typename storage<Target>::type;
+
+    if ( is_aligned<real_type>( dst ) )
+        read_kernel<real_type, Source>()( src, n, reinterpret_cast<real_type*>( dst ) );
+    else
+        scalar::transcode<Source, Target>( src, n, dst );
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst, transcode_path_t<transcode_path::from_native_real> )
+{
+    using real_type = typename storage<Source>::type;
+
+    if ( is_aligned<real_type>( src ) )
+        write_kernel<real_type, Target>()( reinterpret_cast<const real_type*>( src ), n, dst );
+    else
+        scalar::transcode<Source, Target>( src, n, dst );
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst, transcode_path_t<transcode_path::generic> )
+{
+    scalar::transcode<Source, Target>( src, n, dst );
+}
+
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst )
+{
+    transcode<Source, Target>( src, n, dst, transcode_path_t<select_transcode_path<Source, Target>()>{} );
+}
+
+} // namespace detail
+} // namespace pcm
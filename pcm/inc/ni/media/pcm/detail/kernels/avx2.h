@@ -0,0 +1,481 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/cpu.h>
+
+#if NIMEDIA_PCM_SIMD_X86
+
+#include <ni/media/pcm/detail/kernels/scalar.h>
+#include <ni/media/pcm/detail/kernels/traits.h>
+#include <ni/media/pcm/detail/kernels/transcode.h>
+
+#include <immintrin.h>
+
+namespace pcm
+{
+namespace detail
+{
+namespace avx2
+{
+
+// byte shuffles reversing each 16, 32 or 64 bit lane
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i byteswap_mask( bits_t<16> )
+{
+    return _mm256_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, //
+                             1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i byteswap_mask( bits_t<32> )
+{
+    return _mm256_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, //
+                             3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i byteswap_mask( bits_t<64> )
+{
+    return _mm256_setr_epi8( 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, //
+                             7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 );
+}
+
+// reverses 4 packed 24 bit samples in the lower 12 bytes, keeps the upper 4 bytes
+NIMEDIA_PCM_TARGET_AVX2 inline __m128i byteswap_mask( bits_t<24> )
+{
+    return _mm_setr_epi8( 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15 );
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i byteswap( __m256i x, bits_t<bits> b )
+{
+    return _mm256_shuffle_epi8( x, byteswap_mask( b ) );
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_AVX2 inline __m128i to_native( __m128i x, bits_t<bits>, std::true_type /*is_native*/ )
+{
+    return x;
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_AVX2 inline __m128i to_native( __m128i x, bits_t<bits> b, std::false_type /*is_native*/ )
+{
+    return _mm_shuffle_epi8( x, _mm256_castsi256_si128( byteswap_mask( b ) ) );
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i to_native( __m256i x, bits_t<bits>, std::true_type /*is_native*/ )
+{
+    return x;
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i to_native( __m256i x, bits_t<bits> b, std::false_type /*is_native*/ )
+{
+    return byteswap( x, b );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i load( const char* src )
+{
+    return _mm256_loadu_si256( reinterpret_cast<const __m256i*>( src ) );
+}
+
+// loads 8 samples into the upper bits of 32 bit lanes
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i load_top_aligned( const char* src, bits_t<8> )
+{
+    const auto bytes = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( src ) );
+    return _mm256_slli_epi32( _mm256_cvtepu8_epi32( bytes ), 24 );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i load_top_aligned( const char* src, bits_t<16> )
+{
+    const auto words = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+    return _mm256_slli_epi32( _mm256_cvtepu16_epi32( to_native( words, bits_t<16>{}, is_native_format<Format>{} ) ), 16 );
+}
+
+// the shuffle places the three bytes of each sample in little or big endian order
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i top_aligned_mask( bits_t<24>, std::true_type /*is_little_endian*/ )
+{
+    return _mm256_setr_epi8( -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, //
+                             -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11 );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i top_aligned_mask( bits_t<24>, std::false_type /*is_little_endian*/ )
+{
+    return _mm256_setr_epi8( -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, //
+                             -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9 );
+}
+
+// reads 28 bytes: 12 bytes per 128 bit lane plus 4 bytes past the last sample
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i load_top_aligned( const char* src, bits_t<24> )
+{
+    using is_little_endian = std::integral_constant<bool, Format{}.endian() == little_endian>;
+
+    const auto lo = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+    const auto hi = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 12 ) );
+    return _mm256_shuffle_epi8( _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 ),
+                                top_aligned_mask( bits_t<24>{}, is_little_endian{} ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i load_top_aligned( const char* src, bits_t<32> )
+{
+    return to_native( load( src ), bits_t<32>{}, is_native_format<Format>{} );
+}
+
+// loads 8 byte swapped floating point samples and stores them as Value
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_swapped_real( float* dst, const char* src, bits_t<32> )
+{
+    _mm256_storeu_ps( dst, _mm256_castsi256_ps( byteswap( load( src ), bits_t<32>{} ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_swapped_real( double* dst, const char* src, bits_t<32> )
+{
+    const auto samples = _mm256_castsi256_ps( byteswap( load( src ), bits_t<32>{} ) );
+    _mm256_storeu_pd( dst, _mm256_cvtps_pd( _mm256_castps256_ps128( samples ) ) );
+    _mm256_storeu_pd( dst + 4, _mm256_cvtps_pd( _mm256_extractf128_ps( samples, 1 ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_swapped_real( float* dst, const char* src, bits_t<64> )
+{
+    const auto lo = _mm256_cvtpd_ps( _mm256_castsi256_pd( byteswap( load( src ), bits_t<64>{} ) ) );
+    const auto hi = _mm256_cvtpd_ps( _mm256_castsi256_pd( byteswap( load( src + 32 ), bits_t<64>{} ) ) );
+    _mm256_storeu_ps( dst, _mm256_insertf128_ps( _mm256_castps128_ps256( lo ), hi, 1 ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_swapped_real( double* dst, const char* src, bits_t<64> )
+{
+    _mm256_storeu_pd( dst, _mm256_castsi256_pd( byteswap( load( src ), bits_t<64>{} ) ) );
+    _mm256_storeu_pd( dst + 4, _mm256_castsi256_pd( byteswap( load( src + 32 ), bits_t<64>{} ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_real( float* dst, __m256i top_aligned, float scale )
+{
+    _mm256_storeu_ps( dst, _mm256_mul_ps( _mm256_cvtepi32_ps( top_aligned ), _mm256_set1_ps( scale ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_real( double* dst, __m256i top_aligned, double scale )
+{
+    const auto lo = _mm256_cvtepi32_pd( _mm256_castsi256_si128( top_aligned ) );
+    const auto hi = _mm256_cvtepi32_pd( _mm256_extracti128_si256( top_aligned, 1 ) );
+    _mm256_storeu_pd( dst, _mm256_mul_pd( lo, _mm256_set1_pd( scale ) ) );
+    _mm256_storeu_pd( dst + 4, _mm256_mul_pd( hi, _mm256_set1_pd( scale ) ) );
+}
+
+// G.711 decoding of 8 codes in 32 bit lanes straight to float, see sse2::decode
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256 decode( __m256i codes, number_t<alaw> )
+{
+    const auto x    = _mm256_xor_si256( codes, _mm256_set1_epi32( 0x55 ) );
+    const auto s    = _mm256_and_si256( x, _mm256_set1_epi32( 0x7f ) );
+    const auto seg0 = _mm256_cmpgt_epi32( _mm256_set1_epi32( 0x10 ), s );
+
+    const auto s1   = _mm256_or_si256( s, _mm256_and_si256( seg0, _mm256_set1_epi32( 0x10 ) ) );
+    const auto bits = _mm256_add_epi32( _mm256_slli_epi32( s1, 19 ), _mm256_set1_epi32( g711::float_bits ) );
+    const auto mag  = _mm256_sub_ps( _mm256_castsi256_ps( bits ),
+                                    _mm256_and_ps( _mm256_castsi256_ps( seg0 ), _mm256_set1_ps( 1.f / 128 ) ) );
+
+    const auto sign = _mm256_slli_epi32( _mm256_andnot_si256( x, _mm256_set1_epi32( 0x80 ) ), 24 );
+    return _mm256_or_ps( mag, _mm256_castsi256_ps( sign ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline __m256 decode( __m256i codes, number_t<ulaw> )
+{
+    const auto x    = _mm256_xor_si256( codes, _mm256_set1_epi32( 0xff ) );
+    const auto bits = _mm256_add_epi32( _mm256_slli_epi32( _mm256_and_si256( x, _mm256_set1_epi32( 0x7f ) ), 19 ),
+                                        _mm256_set1_epi32( g711::float_bits ) );
+
+    const auto sign = _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_and_si256( x, _mm256_set1_epi32( 0x80 ) ), 24 ) );
+    const auto bias = _mm256_set1_ps( float( g711::ulaw_bias ) / 32768 );
+    return _mm256_sub_ps( _mm256_or_ps( _mm256_castsi256_ps( bits ), sign ), _mm256_or_ps( bias, sign ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_real( float* dst, __m256 samples )
+{
+    _mm256_storeu_ps( dst, samples );
+}
+
+NIMEDIA_PCM_TARGET_AVX2 inline void store_real( double* dst, __m256 samples )
+{
+    _mm256_storeu_pd( dst, _mm256_cvtps_pd( _mm256_castps256_ps128( samples ) ) );
+    _mm256_storeu_pd( dst + 4, _mm256_cvtps_pd( _mm256_extractf128_ps( samples, 1 ) ) );
+}
+
+// converts 8 half floats with f16c, which decodes and rounds exactly like binary16
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline __m256 load_half( const char* src )
+{
+    const auto words = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+    return _mm256_cvtph_ps( to_native( words, bits_t<16>{}, is_native_format<Format>{} ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX2 inline void store_half( char* dst, const float* src )
+{
+    const auto words = _mm256_cvtps_ph( _mm256_loadu_ps( src ), _MM_FROUND_TO_NEAREST_INT );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), to_native( words, bits_t<16>{}, is_native_format<Format>{} ) );
+}
+
+// clamp, upscale and round half away from zero, exactly like convert_to
+NIMEDIA_PCM_TARGET_AVX2 inline __m256i quantize( const float* src, __m256 scale, __m256 max )
+{
+    const auto clamped = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( src ), _mm256_set1_ps( -1.f ) ), max );
+    const auto scaled  = _mm256_mul_ps( clamped, scale );
+    const auto half    = _mm256_or_ps( _mm256_and_ps( scaled, _mm256_set1_ps( -0.f ) ), _mm256_set1_ps( 0.5f ) );
+    return _mm256_cvttps_epi32( _mm256_add_ps( scaled, half ) );
+}
+
+// quantizes and stores 16 samples
+NIMEDIA_PCM_TARGET_AVX2
+inline void store_quantized(
+    char* dst, const float* src, __m256 scale, __m256 max, __m256i flip, __m256i mask, bits_t<16> )
+{
+    const auto packed = _mm256_packs_epi32( quantize( src, scale, max ), quantize( src + 8, scale, max ) );
+    const auto words  = _mm256_permute4x64_epi64( packed, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), _mm256_and_si256( _mm256_xor_si256( words, flip ), mask ) );
+}
+
+// quantizes and stores 8 samples, writes 28 bytes
+NIMEDIA_PCM_TARGET_AVX2
+inline void store_quantized(
+    char* dst, const float* src, __m256 scale, __m256 max, __m256i flip, __m256i mask, bits_t<24> )
+{
+    const auto shuffle = _mm256_setr_epi8( 1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1, //
+                                           1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1 );
+    const auto samples = _mm256_and_si256( _mm256_xor_si256( quantize( src, scale, max ), flip ), mask );
+    const auto packed  = _mm256_shuffle_epi8( samples, shuffle );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm256_castsi256_si128( packed ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 12 ), _mm256_extracti128_si256( packed, 1 ) );
+}
+
+// quantizes and stores 8 samples
+NIMEDIA_PCM_TARGET_AVX2
+inline void store_quantized(
+    char* dst, const float* src, __m256 scale, __m256 max, __m256i flip, __m256i mask, bits_t<32> )
+{
+    const auto quantized = _mm256_xor_si256( quantize( src, scale, max ), flip );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), _mm256_and_si256( quantized, mask ) );
+}
+
+struct kernels
+{
+    template <class Value, class Format>
+    using can_read = std::integral_constant<bool,
+                                            std::is_floating_point<Value>::value
+                                                && ( is_simd_integer_format<Format>::value
+                                                     || is_simd_swapped_format<Format>::value
+                                                     || is_companded_format<Format>::value
+                                                     || is_half_format<Format>::value )>;
+
+    template <class Value, class Format>
+    using can_write = std::integral_constant<bool,
+                                             std::is_same<Value, float>::value
+                                                 && ( ( is_simd_integer_format<Format>::value
+                                                        && kernel_traits<Format>::bits != 8 )
+                                                      || is_half_format<Format>::value )>;
+
+    template <class Source, class Target>
+    using can_byteswap = std::integral_constant<bool, kernel_traits<Source>::bits != 8>;
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read( const char* src, size_t n, Value* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        // the 24 bit loads reach 4 bytes beyond the current block
+        constexpr size_t block = 8;
+        constexpr size_t reach = traits::bits == 24 ? 10 : block;
+
+        const auto flip  = _mm256_set1_epi32( traits::read_flip );
+        const auto mask  = _mm256_set1_epi32( traits::read_mask );
+        const auto scale = traits::template read_scale<Value>();
+
+        size_t i = 0;
+        for ( ; i + reach <= n; i += block, src += block * traits::bytes, dst += block )
+        {
+            const auto samples = _mm256_xor_si256( load_top_aligned<Format>( src, bits_t<traits::bits>{} ), flip );
+            store_real( dst, _mm256_and_si256( samples, mask ), scale );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read_real( const char* src, size_t n, Value* dst, std::false_type /*is_half*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block * traits::bytes, dst += block )
+            store_swapped_real( dst, src, bits_t<traits::bits>{} );
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read_real( const char* src, size_t n, Value* dst, std::true_type /*is_half*/ )
+    {
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block * 2, dst += block )
+            store_real( dst, load_half<Format>( src ) );
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read( const char* src, size_t n, Value* dst, std::false_type /*is_integer*/ )
+    {
+        read_real<Value, Format>( src, n, dst, is_half_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read_n( const char* src, size_t n, Value* dst, std::false_type /*is_companded*/ )
+    {
+        read<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read_n( const char* src, size_t n, Value* dst, std::true_type /*is_companded*/ )
+    {
+        using number = number_t<Format{}.number()>;
+
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block )
+        {
+            const auto codes = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( src ) );
+            store_real( dst, decode( _mm256_cvtepu8_epi32( codes ), number{} ) );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void read( const char* src, size_t n, Value* dst )
+    {
+        read_n<Value, Format>( src, n, dst, is_companded_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void write( const Value* src, size_t n, char* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        // the 24 bit stores reach 4 bytes beyond the current block
+        constexpr size_t block = traits::bits == 16 ? 16 : 8;
+        constexpr size_t reach = traits::bits == 24 ? 10 : block;
+
+        const auto flip  = _mm256_set1_epi32( traits::write_flip );
+        const auto mask  = _mm256_set1_epi32( traits::write_mask );
+        const auto scale = _mm256_set1_ps( traits::template write_scale<float>() );
+        const auto max   = _mm256_set1_ps( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + reach <= n; i += block, src += block, dst += block * traits::bytes )
+            store_quantized( dst, src, scale, max, flip, mask, bits_t<traits::bits>{} );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void write( const Value* src, size_t n, char* dst, std::false_type /*is_integer*/ )
+    {
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block * 2 )
+            store_half<Format>( dst, src );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void write( const Value* src, size_t n, char* dst )
+    {
+        write<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    // 4 samples per 16 byte load and store, the 4 bytes beyond the current block are rewritten by the next one
+    template <class Source, class Target>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void byteswap( const char* src, size_t n, char* dst, bits_t<24> )
+    {
+        const auto mask = byteswap_mask( bits_t<24>{} );
+
+        size_t i = 0;
+        for ( ; i + 6 <= n; i += 4, src += 12, dst += 12 )
+        {
+            const auto samples = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_shuffle_epi8( samples, mask ) );
+        }
+
+        scalar::byteswap<Source, Target>( src, n - i, dst );
+    }
+
+    template <class Source, class Target, int bits>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void byteswap( const char* src, size_t n, char* dst, bits_t<bits> b )
+    {
+        constexpr size_t block = 32 / ( bits / 8 );
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += 32, dst += 32 )
+            _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), avx2::byteswap( load( src ), b ) );
+
+        scalar::byteswap<Source, Target>( src, n - i, dst );
+    }
+
+    template <class Source, class Target>
+    NIMEDIA_PCM_TARGET_AVX2
+    static void byteswap( const char* src, size_t n, char* dst )
+    {
+        byteswap<Source, Target>( src, n, dst, bits_t<kernel_traits<Source>::bits>{} );
+    }
+};
+
+} // namespace avx2
+} // namespace detail
+} // namespace pcm
+
+#endif
@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/cpu.h>
+
+#if NIMEDIA_PCM_SIMD_X86
+
+#include <ni/media/pcm/detail/kernels/scalar.h>
+#include <ni/media/pcm/detail/kernels/traits.h>
+
+#include <immintrin.h>
+
+namespace pcm
+{
+namespace detail
+{
+namespace avx512
+{
+
+// loads 16 samples into the upper bits of 32 bit lanes
+
+NIMEDIA_PCM_TARGET_AVX512 inline __m512i load_top_aligned( const char* src, bits_t<8> )
+{
+    const auto bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+    return _mm512_slli_epi32( _mm512_cvtepu8_epi32( bytes ), 24 );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline __m512i load_top_aligned( const char* src, bits_t<16> )
+{
+    const auto words = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( src ) );
+    return _mm512_slli_epi32( _mm512_cvtepu16_epi32( words ), 16 );
+}
+
+// reads 52 bytes: 12 bytes per 128 bit lane plus 4 bytes past the last sample
+NIMEDIA_PCM_TARGET_AVX512 inline __m512i load_top_aligned( const char* src, bits_t<24> )
+{
+    auto packed = _mm512_castsi128_si512( _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) ) );
+    packed      = _mm512_inserti32x4( packed, _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 12 ) ), 1 );
+    packed      = _mm512_inserti32x4( packed, _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 24 ) ), 2 );
+    packed      = _mm512_inserti32x4( packed, _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + 36 ) ), 3 );
+
+    const auto shuffle = _mm512_broadcast_i32x4( _mm_setr_epi8( -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11 ) );
+    return _mm512_shuffle_epi8( packed, shuffle );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline __m512i load_top_aligned( const char* src, bits_t<32> )
+{
+    return _mm512_loadu_si512( src );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline void store_real( float* dst, __m512i top_aligned, float scale )
+{
+    _mm512_storeu_ps( dst, _mm512_mul_ps( _mm512_cvtepi32_ps( top_aligned ), _mm512_set1_ps( scale ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline void store_real( double* dst, __m512i top_aligned, double scale )
+{
+    const auto lo = _mm512_cvtepi32_pd( _mm512_castsi512_si256( top_aligned ) );
+    const auto hi = _mm512_cvtepi32_pd( _mm512_extracti64x4_epi64( top_aligned, 1 ) );
+    _mm512_storeu_pd( dst, _mm512_mul_pd( lo, _mm512_set1_pd( scale ) ) );
+    _mm512_storeu_pd( dst + 8, _mm512_mul_pd( hi, _mm512_set1_pd( scale ) ) );
+}
+
+// 16 half floats, converted like binary16 and swapped as 16 bit words for the foreign endian
+
+NIMEDIA_PCM_TARGET_AVX512 inline __m256i to_native( __m256i words, std::true_type /*is_native*/ )
+{
+    return words;
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline __m256i to_native( __m256i words, std::false_type /*is_native*/ )
+{
+    return _mm256_or_si256( _mm256_slli_epi16( words, 8 ), _mm256_srli_epi16( words, 8 ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX512 inline __m512 load_half( const char* src )
+{
+    const auto words = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( src ) );
+    return _mm512_cvtph_ps( to_native( words, is_native_format<Format>{} ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_AVX512 inline void store_half( char* dst, const float* src )
+{
+    const auto words = _mm512_cvtps_ph( _mm512_loadu_ps( src ), _MM_FROUND_TO_NEAREST_INT );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), to_native( words, is_native_format<Format>{} ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline void store_real( float* dst, __m512 samples )
+{
+    _mm512_storeu_ps( dst, samples );
+}
+
+NIMEDIA_PCM_TARGET_AVX512 inline void store_real( double* dst, __m512 samples )
+{
+    const auto hi = _mm256_castpd_ps( _mm512_extractf64x4_pd( _mm512_castps_pd( samples ), 1 ) );
+    _mm512_storeu_pd( dst, _mm512_cvtps_pd( _mm512_castps512_ps256( samples ) ) );
+    _mm512_storeu_pd( dst + 8, _mm512_cvtps_pd( hi ) );
+}
+
+// clamp, upscale and round half away from zero, exactly like convert_to
+NIMEDIA_PCM_TARGET_AVX512 inline __m512i quantize( const float* src, __m512 scale, __m512 max )
+{
+    const auto clamped = _mm512_min_ps( _mm512_max_ps( _mm512_loadu_ps( src ), _mm512_set1_ps( -1.f ) ), max );
+    const auto scaled  = _mm512_mul_ps( clamped, scale );
+    const auto sign    = _mm512_and_si512( _mm512_castps_si512( scaled ), _mm512_set1_epi32( ~0x7fffffff ) );
+    const auto half    = _mm512_castsi512_ps( _mm512_or_si512( sign, _mm512_castps_si512( _mm512_set1_ps( 0.5f ) ) ) );
+    return _mm512_cvttps_epi32( _mm512_add_ps( scaled, half ) );
+}
+
+// quantizes and stores 16 samples
+
+NIMEDIA_PCM_TARGET_AVX512
+inline void store_quantized(
+    char* dst, const float* src, __m512 scale, __m512 max, __m512i flip, __m512i /*mask*/, bits_t<8> )
+{
+    const auto bytes = _mm512_cvtsepi32_epi8( quantize( src, scale, max ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_xor_si128( bytes, _mm512_castsi512_si128( flip ) ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX512
+inline void store_quantized(
+    char* dst, const float* src, __m512 scale, __m512 max, __m512i flip, __m512i mask, bits_t<16> )
+{
+    const auto words   = _mm512_cvtsepi32_epi16( quantize( src, scale, max ) );
+    const auto flipped = _mm256_xor_si256( words, _mm512_castsi512_si256( flip ) );
+    const auto masked  = _mm256_and_si256( flipped, _mm512_castsi512_si256( mask ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), masked );
+}
+
+// writes 52 bytes
+NIMEDIA_PCM_TARGET_AVX512
+inline void store_quantized(
+    char* dst, const float* src, __m512 scale, __m512 max, __m512i flip, __m512i mask, bits_t<24> )
+{
+    const auto shuffle = _mm512_broadcast_i32x4( _mm_setr_epi8( 1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1 ) );
+    const auto samples = _mm512_and_si512( _mm512_xor_si512( quantize( src, scale, max ), flip ), mask );
+    const auto packed  = _mm512_shuffle_epi8( samples, shuffle );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm512_extracti32x4_epi32( packed, 0 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 12 ), _mm512_extracti32x4_epi32( packed, 1 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 24 ), _mm512_extracti32x4_epi32( packed, 2 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 36 ), _mm512_extracti32x4_epi32( packed, 3 ) );
+}
+
+NIMEDIA_PCM_TARGET_AVX512
+inline void store_quantized(
+    char* dst, const float* src, __m512 scale, __m512 max, __m512i flip, __m512i mask, bits_t<32> )
+{
+    _mm512_storeu_si512( dst, _mm512_and_si512( _mm512_xor_si512( quantize( src, scale, max ), flip ), mask ) );
+}
+
+struct kernels
+{
+    template <class Value, class Format>
+    using can_read = std::integral_constant<bool,
+                                            std::is_floating_point<Value>::value
+                                                && ( is_simd_integer_format<Format>::value
+                                                     || is_half_format<Format>::value )>;
+
+    template <class Value, class Format>
+    using can_write = std::integral_constant<bool,
+                                             std::is_same<Value, float>::value
+                                                 && ( is_simd_integer_format<Format>::value
+                                                      || is_half_format<Format>::value )>;
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void read( const char* src, size_t n, Value* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        // the 24 bit loads reach 4 bytes beyond the current block
+        constexpr size_t block = 16;
+        constexpr size_t reach = traits::bits == 24 ? 18 : block;
+
+        const auto flip  = _mm512_set1_epi32( traits::read_flip );
+        const auto mask  = _mm512_set1_epi32( traits::read_mask );
+        const auto scale = traits::template read_scale<Value>();
+
+        size_t i = 0;
+        for ( ; i + reach <= n; i += block, src += block * traits::bytes, dst += block )
+        {
+            const auto samples = _mm512_xor_si512( load_top_aligned( src, bits_t<traits::bits>{} ), flip );
+            store_real( dst, _mm512_and_si512( samples, mask ), scale );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void read( const char* src, size_t n, Value* dst, std::false_type /*is_integer*/ )
+    {
+        constexpr size_t block = 16;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block * 2, dst += block )
+            store_real( dst, load_half<Format>( src ) );
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void read( const char* src, size_t n, Value* dst )
+    {
+        read<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void write( const Value* src, size_t n, char* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        // the 24 bit stores reach 4 bytes beyond the current block
+        constexpr size_t block = 16;
+        constexpr size_t reach = traits::bits == 24 ? 18 : block;
+
+        const auto flip  = _mm512_set1_epi32( traits::write_flip );
+        const auto mask  = _mm512_set1_epi32( traits::write_mask );
+        const auto scale = _mm512_set1_ps( traits::template write_scale<float>() );
+        const auto max   = _mm512_set1_ps( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + reach <= n; i += block, src += block, dst += block * traits::bytes )
+            store_quantized( dst, src, scale, max, flip, mask, bits_t<traits::bits>{} );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void write( const Value* src, size_t n, char* dst, std::false_type /*is_integer*/ )
+    {
+        constexpr size_t block = 16;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block * 2 )
+            store_half<Format>( dst, src );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_AVX512 static void write( const Value* src, size_t n, char* dst )
+    {
+        write<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+};
+
+} // namespace avx512
+} // namespace detail
+} // namespace pcm
+
+#endif
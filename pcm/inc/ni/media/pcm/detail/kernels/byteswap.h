@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace pcm
+{
+namespace detail
+{
+
+// written as shifts, which compilers turn into bswap / rev instructions
+
+inline uint8_t byteswap( uint8_t word )
+{
+    return word;
+}
+
+inline uint16_t byteswap( uint16_t word )
+{
+    return uint16_t( ( word >> 8 ) | ( word << 8 ) );
+}
+
+inline uint32_t byteswap( uint32_t word )
+{
+    return ( word >> 24 ) | ( ( word >> 8 ) & 0xff00u ) | ( ( word << 8 ) & 0xff0000u ) | ( word << 24 );
+}
+
+inline uint64_t byteswap( uint64_t word )
+{
+    return ( uint64_t( byteswap( uint32_t( word ) ) ) << 32 ) | byteswap( uint32_t( word >> 32 ) );
+}
+
+} // namespace detail
+} // namespace pcm
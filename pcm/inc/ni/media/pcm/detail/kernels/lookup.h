@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/detail/kernels/sample.h>
+#include <ni/media/pcm/detail/kernels/traits.h>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace pcm
+{
+namespace detail
+{
+namespace lookup
+{
+
+// 8 and 16 bit integer samples have at most 65536 distinct values, so the conversion to
+// float / double is a single table load. The table is indexed by the sample word as it is
+// stored, byte order included, and built on first use. A-law and mu-law decode with the same
+// 256 entry tables as 8 bit integers, half floats without F16C with a 65536 entry table.
+template <class Value, class Format>
+using can_read = std::integral_constant<bool,
+                                        std::is_floating_point<Value>::value
+                                            && ( kernel_traits<Format>::is_integer
+                                                 || kernel_traits<Format>::is_companded
+                                                 || kernel_traits<Format>::is_half )
+                                            && kernel_traits<Format>::bits <= 16>;
+
+template <class Format>
+using index_t = word_t<kernel_traits<Format>::bytes>;
+
+template <class Value, class Format>
+auto make_table()
+{
+    using index_type = index_t<Format>;
+
+    auto table = std::vector<Value>( size_t( 1 ) << kernel_traits<Format>::bits );
+    for ( size_t i = 0; i < table.size(); ++i )
+    {
+        const auto word = index_type( i );
+        char       bytes[sizeof( word )];
+        std::memcpy( bytes, &word, sizeof( word ) );
+        table[i] = convert_to<Value>( load_sample<Format>( bytes ) );
+    }
+    return table;
+}
+
+template <class Value, class Format>
+auto table() -> const Value*
+{
+    static const auto values = make_table<Value, Format>();
+    return values.data();
+}
+
+template <class Value, class Format>
+void read( const char* src, size_t n, Value* dst )
+{
+    using index_type = index_t<Format>;
+
+    const auto values = table<Value, Format>();
+    for ( size_t i = 0; i < n; ++i, src += sizeof( index_type ) )
+    {
+        index_type word;
+        std::memcpy( &word, src, sizeof( word ) );
+        dst[i] = values[word];
+    }
+}
+
+} // namespace lookup
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,727 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/cpu.h>
+
+#if NIMEDIA_PCM_SIMD_NEON
+
+#include <ni/media/pcm/detail/kernels/scalar.h>
+#include <ni/media/pcm/detail/kernels/traits.h>
+#include <ni/media/pcm/detail/kernels/transcode.h>
+
+#include <arm_neon.h>
+
+#include <algorithm>
+#include <utility>
+
+// half float conversions need the fp16 extension on 32 bit arm
+#if defined( __aarch64__ ) || ( defined( __ARM_FP ) && ( __ARM_FP & 2 ) )
+#define NIMEDIA_PCM_NEON_FP16 1
+#else
+#define NIMEDIA_PCM_NEON_FP16 0
+#endif
+
+namespace pcm
+{
+namespace detail
+{
+namespace neon
+{
+
+// reverses the bytes of each 16, 32 or 64 bit lane
+
+inline uint8x16_t byteswap( uint8x16_t x, bits_t<16> )
+{
+    return vrev16q_u8( x );
+}
+
+inline uint8x16_t byteswap( uint8x16_t x, bits_t<32> )
+{
+    return vrev32q_u8( x );
+}
+
+inline uint8x16_t byteswap( uint8x16_t x, bits_t<64> )
+{
+    return vrev64q_u8( x );
+}
+
+template <int bits>
+inline uint8x16_t to_native( uint8x16_t x, bits_t<bits>, std::true_type /*is_native*/ )
+{
+    return x;
+}
+
+template <int bits>
+inline uint8x16_t to_native( uint8x16_t x, bits_t<bits> b, std::false_type /*is_native*/ )
+{
+    return byteswap( x, b );
+}
+
+inline uint8x16_t load( const char* src )
+{
+    return vld1q_u8( reinterpret_cast<const uint8_t*>( src ) );
+}
+
+// loads 8 samples into the upper bits of 32 bit lanes
+
+template <class Format>
+inline uint32x4x2_t load_top_aligned( const char* src, bits_t<8> )
+{
+    const auto words = vshll_n_u8( vld1_u8( reinterpret_cast<const uint8_t*>( src ) ), 8 );
+    return {{vshll_n_u16( vget_low_u16( words ), 16 ), vshll_n_u16( vget_high_u16( words ), 16 )}};
+}
+
+template <class Format>
+inline uint32x4x2_t load_top_aligned( const char* src, bits_t<16> )
+{
+    const auto words = vreinterpretq_u16_u8( to_native( load( src ), bits_t<16>{}, is_native_format<Format>{} ) );
+    return {{vshll_n_u16( vget_low_u16( words ), 16 ), vshll_n_u16( vget_high_u16( words ), 16 )}};
+}
+
+// vld3 splits the bytes of each sample, big endian samples only swap the first and the last byte
+template <class Format>
+inline uint32x4x2_t load_top_aligned( const char* src, bits_t<24> )
+{
+    constexpr int low  = Format{}.endian() == little_endian ? 0 : 2;
+    constexpr int high = 2 - low;
+
+    const auto bytes = vld3_u8( reinterpret_cast<const uint8_t*>( src ) );
+    const auto lo    = vshll_n_u8( bytes.val[low], 8 );
+    const auto hi    = vorrq_u16( vmovl_u8( bytes.val[1] ), vshll_n_u8( bytes.val[high], 8 ) );
+    return {{vorrq_u32( vshll_n_u16( vget_low_u16( hi ), 16 ), vmovl_u16( vget_low_u16( lo ) ) ),
+             vorrq_u32( vshll_n_u16( vget_high_u16( hi ), 16 ), vmovl_u16( vget_high_u16( lo ) ) )}};
+}
+
+template <class Format>
+inline uint32x4x2_t load_top_aligned( const char* src, bits_t<32> )
+{
+    using is_native = is_native_format<Format>;
+    return {{vreinterpretq_u32_u8( to_native( load( src ), bits_t<32>{}, is_native{} ) ),
+             vreinterpretq_u32_u8( to_native( load( src + 16 ), bits_t<32>{}, is_native{} ) )}};
+}
+
+inline void store_real( float* dst, uint32x4_t top_aligned, float scale )
+{
+    vst1q_f32( dst, vmulq_n_f32( vcvtq_f32_s32( vreinterpretq_s32_u32( top_aligned ) ), scale ) );
+}
+
+#if NIMEDIA_PCM_NEON_FP16
+
+// converts 8 half floats, the fpu decodes and rounds them exactly like binary16
+
+template <class Format>
+inline float32x4x2_t load_half( const char* src )
+{
+    const auto words = vreinterpretq_u16_u8( to_native( load( src ), bits_t<16>{}, is_native_format<Format>{} ) );
+    return {{vcvt_f32_f16( vreinterpret_f16_u16( vget_low_u16( words ) ) ),
+             vcvt_f32_f16( vreinterpret_f16_u16( vget_high_u16( words ) ) )}};
+}
+
+template <class Format>
+inline void store_half( char* dst, const float* src )
+{
+    const auto lo    = vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( src ) ) );
+    const auto hi    = vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( src + 4 ) ) );
+    const auto words = vreinterpretq_u8_u16( vcombine_u16( lo, hi ) );
+    vst1q_u8( reinterpret_cast<uint8_t*>( dst ), to_native( words, bits_t<16>{}, is_native_format<Format>{} ) );
+}
+
+#endif
+
+// clamp, upscale and round half away from zero, exactly like convert_to
+inline uint32x4_t quantize( const float* src, float32x4_t scale, float32x4_t max )
+{
+    const auto clamped = vminq_f32( vmaxq_f32( vld1q_f32( src ), vdupq_n_f32( -1.f ) ), max );
+    const auto scaled  = vmulq_f32( clamped, scale );
+    const auto sign    = vandq_u32( vreinterpretq_u32_f32( scaled ), vdupq_n_u32( 0x80000000u ) );
+    const auto half    = vreinterpretq_f32_u32( vorrq_u32( sign, vreinterpretq_u32_f32( vdupq_n_f32( 0.5f ) ) ) );
+    return vreinterpretq_u32_s32( vcvtq_s32_f32( vaddq_f32( scaled, half ) ) );
+}
+
+// quantizes and stores 8 samples
+
+inline void store_quantized(
+    char* dst, const float* src, float32x4_t scale, float32x4_t max, uint32x4_t flip, uint32x4_t mask, bits_t<16> )
+{
+    const auto lo    = vqmovn_s32( vreinterpretq_s32_u32( quantize( src, scale, max ) ) );
+    const auto hi    = vqmovn_s32( vreinterpretq_s32_u32( quantize( src + 4, scale, max ) ) );
+    const auto words = veorq_u16( vreinterpretq_u16_s16( vcombine_s16( lo, hi ) ), vreinterpretq_u16_u32( flip ) );
+    vst1q_u16( reinterpret_cast<uint16_t*>( dst ), vandq_u16( words, vreinterpretq_u16_u32( mask ) ) );
+}
+
+inline void store_quantized(
+    char* dst, const float* src, float32x4_t scale, float32x4_t max, uint32x4_t flip, uint32x4_t mask, bits_t<24> )
+{
+    const auto lo  = vandq_u32( veorq_u32( quantize( src, scale, max ), flip ), mask );
+    const auto hi  = vandq_u32( veorq_u32( quantize( src + 4, scale, max ), flip ), mask );
+    const auto mid = vcombine_u16( vshrn_n_u32( lo, 8 ), vshrn_n_u32( hi, 8 ) );
+    const auto top = vcombine_u16( vshrn_n_u32( lo, 16 ), vshrn_n_u32( hi, 16 ) );
+
+    uint8x8x3_t bytes;
+    bytes.val[0] = vmovn_u16( mid );
+    bytes.val[1] = vmovn_u16( top );
+    bytes.val[2] = vshrn_n_u16( top, 8 );
+    vst3_u8( reinterpret_cast<uint8_t*>( dst ), bytes );
+}
+
+inline void store_quantized(
+    char* dst, const float* src, float32x4_t scale, float32x4_t max, uint32x4_t flip, uint32x4_t mask, bits_t<32> )
+{
+    const auto words = reinterpret_cast<uint32_t*>( dst );
+    vst1q_u32( words, vandq_u32( veorq_u32( quantize( src, scale, max ), flip ), mask ) );
+    vst1q_u32( words + 4, vandq_u32( veorq_u32( quantize( src + 4, scale, max ), flip ), mask ) );
+}
+
+// G.711 encoding of 8 linear 16 bit samples. The segment counts the segment ends below the sample,
+// the mantissa shift grows by one with every segment end passed.
+
+inline uint16x8_t encode( int16x8_t linear, number_t<alaw> )
+{
+    const auto sign = vreinterpretq_u16_s16( vshrq_n_s16( linear, 15 ) );
+    const auto val  = veorq_u16( vreinterpretq_u16_s16( vshrq_n_s16( linear, 3 ) ), sign ); // -val - 1 for negative
+
+    auto seg      = vdupq_n_u16( 0 );
+    auto mantissa = vshrq_n_u16( val, 1 );
+    for ( int k = 0; k < 8; ++k )
+    {
+        const auto above = vcgtq_s16( vreinterpretq_s16_u16( val ), vdupq_n_s16( g711::alaw_segment_ends[k] ) );
+        seg              = vsubq_u16( seg, above );
+        if ( k > 0 )
+            mantissa = vbslq_u16( above, vshrq_n_u16( mantissa, 1 ), mantissa );
+    }
+
+    const auto code = vorrq_u16( vshlq_n_u16( seg, 4 ), vandq_u16( mantissa, vdupq_n_u16( 0x0f ) ) );
+    const auto mask = veorq_u16( vdupq_n_u16( 0xd5 ), vandq_u16( sign, vdupq_n_u16( 0x80 ) ) );
+    return veorq_u16( code, mask );
+}
+
+inline uint16x8_t encode( int16x8_t linear, number_t<ulaw> )
+{
+    const auto sign = vreinterpretq_u16_s16( vshrq_n_s16( linear, 15 ) );
+    const auto mag  = vabsq_s16( vshrq_n_s16( linear, 2 ) );
+    const auto val  = vreinterpretq_u16_s16( vaddq_s16( vminq_s16( mag, vdupq_n_s16( g711::ulaw_clip ) ),
+                                                       vdupq_n_s16( g711::ulaw_bias >> 2 ) ) );
+
+    auto seg      = vdupq_n_u16( 0 );
+    auto mantissa = vshrq_n_u16( val, 1 );
+    auto above    = vdupq_n_u16( 0 );
+    for ( int k = 0; k < 8; ++k )
+    {
+        above    = vcgtq_u16( val, vdupq_n_u16( uint16_t( g711::ulaw_segment_ends[k] ) ) );
+        seg      = vsubq_u16( seg, above );
+        mantissa = vbslq_u16( above, vshrq_n_u16( mantissa, 1 ), mantissa );
+    }
+
+    // beyond the last segment the code saturates
+    const auto code = vbslq_u16(
+        above, vdupq_n_u16( 0x7f ), vorrq_u16( vshlq_n_u16( seg, 4 ), vandq_u16( mantissa, vdupq_n_u16( 0x0f ) ) ) );
+    const auto mask = veorq_u16( vdupq_n_u16( 0xff ), vandq_u16( sign, vdupq_n_u16( 0x80 ) ) );
+    return veorq_u16( code, mask );
+}
+
+// G.711 decoding of 4 codes in 32 bit lanes straight to float, see g711::float_bits
+
+inline float32x4_t decode( uint32x4_t codes, number_t<alaw> )
+{
+    const auto x    = veorq_u32( codes, vdupq_n_u32( 0x55 ) );
+    const auto s    = vandq_u32( x, vdupq_n_u32( 0x7f ) );
+    const auto seg0 = vcltq_u32( s, vdupq_n_u32( 0x10 ) );
+
+    const auto s1   = vorrq_u32( s, vandq_u32( seg0, vdupq_n_u32( 0x10 ) ) );
+    const auto bits = vaddq_u32( vshlq_n_u32( s1, 19 ), vdupq_n_u32( uint32_t( g711::float_bits ) ) );
+    const auto step = vandq_u32( seg0, vreinterpretq_u32_f32( vdupq_n_f32( 1.f / 128 ) ) );
+    const auto mag  = vsubq_f32( vreinterpretq_f32_u32( bits ), vreinterpretq_f32_u32( step ) );
+
+    const auto sign = vshlq_n_u32( vbicq_u32( vdupq_n_u32( 0x80 ), x ), 24 );
+    return vreinterpretq_f32_u32( vorrq_u32( vreinterpretq_u32_f32( mag ), sign ) );
+}
+
+inline float32x4_t decode( uint32x4_t codes, number_t<ulaw> )
+{
+    const auto x    = veorq_u32( codes, vdupq_n_u32( 0xff ) );
+    const auto bits = vaddq_u32( vshlq_n_u32( vandq_u32( x, vdupq_n_u32( 0x7f ) ), 19 ),
+                                 vdupq_n_u32( uint32_t( g711::float_bits ) ) );
+
+    // -t + bias instead of -(t - bias), zero stays positive
+    const auto sign = vshlq_n_u32( vandq_u32( x, vdupq_n_u32( 0x80 ) ), 24 );
+    const auto bias = vreinterpretq_u32_f32( vdupq_n_f32( float( g711::ulaw_bias ) / 32768 ) );
+    return vsubq_f32( vreinterpretq_f32_u32( vorrq_u32( bits, sign ) ),
+                      vreinterpretq_f32_u32( vorrq_u32( bias, sign ) ) );
+}
+
+struct kernels
+{
+    template <class Value, class Format>
+    using can_read = std::integral_constant<bool,
+                                            std::is_same<Value, float>::value
+                                                && ( is_simd_integer_format<Format>::value
+                                                     || ( is_simd_swapped_format<Format>::value
+                                                          && kernel_traits<Format>::bits <= 32 )
+                                                     || is_companded_format<Format>::value
+                                                     || ( is_half_format<Format>::value && NIMEDIA_PCM_NEON_FP16 ) )>;
+
+    template <class Value, class Format>
+    using can_write = std::integral_constant<bool,
+                                             std::is_same<Value, float>::value
+                                                 && ( ( is_simd_integer_format<Format>::value
+                                                        && kernel_traits<Format>::bits != 8 )
+                                                      || is_companded_format<Format>::value
+                                                      || ( is_half_format<Format>::value && NIMEDIA_PCM_NEON_FP16 ) )>;
+
+    template <class Source, class Target>
+    using can_byteswap = std::integral_constant<bool, kernel_traits<Source>::bits != 8>;
+
+    template <class Value, class Format>
+    static void read( const char* src, size_t n, Value* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        constexpr size_t block = 8;
+
+        const auto flip  = vdupq_n_u32( uint32_t( traits::read_flip ) );
+        const auto mask  = vdupq_n_u32( uint32_t( traits::read_mask ) );
+        const auto scale = traits::template read_scale<Value>();
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block * traits::bytes, dst += block )
+        {
+            const auto samples = load_top_aligned<Format>( src, bits_t<traits::bits>{} );
+            store_real( dst, vandq_u32( veorq_u32( samples.val[0], flip ), mask ), scale );
+            store_real( dst + 4, vandq_u32( veorq_u32( samples.val[1], flip ), mask ), scale );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    // byte swapped 32 bit floats
+    template <class Value, class Format>
+    static void read_real( const char* src, size_t n, Value* dst, std::false_type /*is_half*/ )
+    {
+        constexpr size_t block = 4;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += 16, dst += block )
+            vst1q_f32( dst, vreinterpretq_f32_u8( byteswap( load( src ), bits_t<32>{} ) ) );
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+#if NIMEDIA_PCM_NEON_FP16
+    template <class Value, class Format>
+    static void read_real( const char* src, size_t n, Value* dst, std::true_type /*is_half*/ )
+    {
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += 16, dst += block )
+        {
+            const auto samples = load_half<Format>( src );
+            vst1q_f32( dst, samples.val[0] );
+            vst1q_f32( dst + 4, samples.val[1] );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+#endif
+
+    template <class Value, class Format>
+    static void read( const char* src, size_t n, Value* dst, std::false_type /*is_integer*/ )
+    {
+        read_real<Value, Format>( src, n, dst, is_half_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    static void read_n( const char* src, size_t n, Value* dst, std::false_type /*is_companded*/ )
+    {
+        read<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    static void read_n( const char* src, size_t n, Value* dst, std::true_type /*is_companded*/ )
+    {
+        using number = number_t<Format{}.number()>;
+
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block )
+        {
+            const auto codes = vmovl_u8( vld1_u8( reinterpret_cast<const uint8_t*>( src ) ) );
+            vst1q_f32( dst, decode( vmovl_u16( vget_low_u16( codes ) ), number{} ) );
+            vst1q_f32( dst + 4, decode( vmovl_u16( vget_high_u16( codes ) ), number{} ) );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    static void read( const char* src, size_t n, Value* dst )
+    {
+        read_n<Value, Format>( src, n, dst, is_companded_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    static void write( const Value* src, size_t n, char* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        constexpr size_t block = 8;
+
+        const auto flip  = vdupq_n_u32( uint32_t( traits::write_flip ) );
+        const auto mask  = vdupq_n_u32( uint32_t( traits::write_mask ) );
+        const auto scale = vdupq_n_f32( traits::template write_scale<float>() );
+        const auto max   = vdupq_n_f32( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block * traits::bytes )
+            store_quantized( dst, src, scale, max, flip, mask, bits_t<traits::bits>{} );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+#if NIMEDIA_PCM_NEON_FP16
+    template <class Value, class Format>
+    static void write( const Value* src, size_t n, char* dst, std::false_type /*is_integer*/ )
+    {
+        constexpr size_t block = 8;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += 16 )
+            store_half<Format>( dst, src );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+#endif
+
+    template <class Value, class Format>
+    static void write_n( const Value* src, size_t n, char* dst, std::false_type /*is_companded*/ )
+    {
+        write<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    // quantized to 16 bit like convert_to<int16_t>, then encoded
+    template <class Value, class Format>
+    static void write_n( const Value* src, size_t n, char* dst, std::true_type /*is_companded*/ )
+    {
+        using traits = kernel_traits<Format>;
+        using number = number_t<Format{}.number()>;
+
+        const auto scale = vdupq_n_f32( traits::template write_scale<float>() );
+        const auto max   = vdupq_n_f32( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + 8 <= n; i += 8, src += 8, dst += 8 )
+        {
+            const auto lo    = vqmovn_s32( vreinterpretq_s32_u32( quantize( src, scale, max ) ) );
+            const auto hi    = vqmovn_s32( vreinterpretq_s32_u32( quantize( src + 4, scale, max ) ) );
+            const auto codes = encode( vcombine_s16( lo, hi ), number{} );
+            vst1_u8( reinterpret_cast<uint8_t*>( dst ), vmovn_u16( codes ) );
+        }
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    static void write( const Value* src, size_t n, char* dst )
+    {
+        write_n<Value, Format>( src, n, dst, is_companded_format<Format>{} );
+    }
+
+    // 8 samples per iteration, the bytes of 24 bit samples are split with vld3
+    template <class Source, class Target>
+    static void byteswap( const char* src, size_t n, char* dst, bits_t<24> )
+    {
+        size_t i = 0;
+        for ( ; i + 8 <= n; i += 8, src += 24, dst += 24 )
+        {
+            const auto bytes = vld3_u8( reinterpret_cast<const uint8_t*>( src ) );
+
+            uint8x8x3_t swapped;
+            swapped.val[0] = bytes.val[2];
+            swapped.val[1] = bytes.val[1];
+            swapped.val[2] = bytes.val[0];
+            vst3_u8( reinterpret_cast<uint8_t*>( dst ), swapped );
+        }
+
+        scalar::byteswap<Source, Target>( src, n - i, dst );
+    }
+
+    template <class Source, class Target, int bits>
+    static void byteswap( const char* src, size_t n, char* dst, bits_t<bits> b )
+    {
+        constexpr size_t block = 16 / ( bits / 8 );
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += 16, dst += 16 )
+            vst1q_u8( reinterpret_cast<uint8_t*>( dst ), neon::byteswap( load( src ), b ) );
+
+        scalar::byteswap<Source, Target>( src, n - i, dst );
+    }
+
+    template <class Source, class Target>
+    static void byteswap( const char* src, size_t n, char* dst )
+    {
+        byteswap<Source, Target>( src, n, dst, bits_t<kernel_traits<Source>::bits>{} );
+    }
+};
+
+inline void transpose( float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3 )
+{
+    const auto t01 = vtrnq_f32( r0, r1 );
+    const auto t23 = vtrnq_f32( r2, r3 );
+    r0             = vcombine_f32( vget_low_f32( t01.val[0] ), vget_low_f32( t23.val[0] ) );
+    r1             = vcombine_f32( vget_low_f32( t01.val[1] ), vget_low_f32( t23.val[1] ) );
+    r2             = vcombine_f32( vget_high_f32( t01.val[0] ), vget_high_f32( t23.val[0] ) );
+    r3             = vcombine_f32( vget_high_f32( t01.val[1] ), vget_high_f32( t23.val[1] ) );
+}
+
+// deinterleaves 4 frames at a time, see sse2::deinterleave
+inline void deinterleave( const float* src, size_t frames, size_t channels, float* const* dst, size_t offset )
+{
+    size_t f = 0;
+
+    if ( channels == 2 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto lr = vld2q_f32( src + 2 * f );
+            vst1q_f32( dst[0] + offset + f, lr.val[0] );
+            vst1q_f32( dst[1] + offset + f, lr.val[1] );
+        }
+    }
+    else if ( channels >= 4 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto frame = src + f * channels;
+            for ( size_t c = 0; c < channels; c += 4 )
+            {
+                const auto first = std::min( c, channels - 4 );
+
+                auto r0 = vld1q_f32( frame + first );
+                auto r1 = vld1q_f32( frame + channels + first );
+                auto r2 = vld1q_f32( frame + 2 * channels + first );
+                auto r3 = vld1q_f32( frame + 3 * channels + first );
+                transpose( r0, r1, r2, r3 );
+
+                vst1q_f32( dst[first] + offset + f, r0 );
+                vst1q_f32( dst[first + 1] + offset + f, r1 );
+                vst1q_f32( dst[first + 2] + offset + f, r2 );
+                vst1q_f32( dst[first + 3] + offset + f, r3 );
+            }
+        }
+    }
+
+    scalar::deinterleave( src + f * channels, frames - f, channels, dst, offset + f );
+}
+
+// the inverse of deinterleave
+inline void interleave( const float* const* src, size_t offset, size_t frames, size_t channels, float* dst )
+{
+    size_t f = 0;
+
+    if ( channels == 2 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            float32x4x2_t lr;
+            lr.val[0] = vld1q_f32( src[0] + offset + f );
+            lr.val[1] = vld1q_f32( src[1] + offset + f );
+            vst2q_f32( dst + 2 * f, lr );
+        }
+    }
+    else if ( channels >= 4 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto frame = dst + f * channels;
+            for ( size_t c = 0; c < channels; c += 4 )
+            {
+                const auto first = std::min( c, channels - 4 );
+
+                auto r0 = vld1q_f32( src[first] + offset + f );
+                auto r1 = vld1q_f32( src[first + 1] + offset + f );
+                auto r2 = vld1q_f32( src[first + 2] + offset + f );
+                auto r3 = vld1q_f32( src[first + 3] + offset + f );
+                transpose( r0, r1, r2, r3 );
+
+                vst1q_f32( frame + first, r0 );
+                vst1q_f32( frame + channels + first, r1 );
+                vst1q_f32( frame + 2 * channels + first, r2 );
+                vst1q_f32( frame + 3 * channels + first, r3 );
+            }
+        }
+    }
+
+    scalar::interleave( src, offset + f, frames - f, channels, dst + f * channels );
+}
+
+// mono to stereo, 4 frames at a time
+inline void mix_1_2( const float* src, size_t frames, size_t, size_t, const float* matrix, float* dst )
+{
+    size_t f = 0;
+    for ( ; f + 4 <= frames; f += 4 )
+    {
+        const auto    mono = vld1q_f32( src + f );
+        float32x4x2_t lr;
+        lr.val[0] = vmulq_n_f32( mono, matrix[0] );
+        lr.val[1] = vmulq_n_f32( mono, matrix[1] );
+        vst2q_f32( dst + 2 * f, lr );
+    }
+
+    scalar::mix_fixed<float, 1, 2>( src + f, frames - f, 1, 2, matrix, dst + 2 * f );
+}
+
+// stereo to mono, 4 frames at a time
+inline void mix_2_1( const float* src, size_t frames, size_t, size_t, const float* matrix, float* dst )
+{
+    size_t f = 0;
+    for ( ; f + 4 <= frames; f += 4 )
+    {
+        const auto lr = vld2q_f32( src + 2 * f );
+        vst1q_f32( dst + f, vaddq_f32( vmulq_n_f32( lr.val[0], matrix[0] ), vmulq_n_f32( lr.val[1], matrix[1] ) ) );
+    }
+
+    scalar::mix_fixed<float, 2, 1>( src + 2 * f, frames - f, 2, 1, matrix, dst + f );
+}
+
+// block reductions, 4 floats at a time. neon on 32 bit arm has no double lanes, the sums stay scalar.
+
+inline auto min_max( const float* src, size_t n, std::pair<float, float> result ) -> std::pair<float, float>
+{
+    if ( n < 4 )
+        return scalar::min_max( src, n, result );
+
+    auto lo = vdupq_n_f32( result.first );
+    auto hi = vdupq_n_f32( result.second );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto x = vld1q_f32( src + i );
+        lo           = vminq_f32( lo, x );
+        hi           = vmaxq_f32( hi, x );
+    }
+
+    const auto lo2 = vpmin_f32( vget_low_f32( lo ), vget_high_f32( lo ) );
+    const auto hi2 = vpmax_f32( vget_low_f32( hi ), vget_high_f32( hi ) );
+    result.first   = vget_lane_f32( vpmin_f32( lo2, lo2 ), 0 );
+    result.second  = vget_lane_f32( vpmax_f32( hi2, hi2 ), 0 );
+
+    return scalar::min_max( src + i, n - i, result );
+}
+
+inline auto peak( const float* src, size_t n, float result ) -> float
+{
+    auto hi = vdupq_n_f32( result );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        hi = vmaxq_f32( hi, vabsq_f32( vld1q_f32( src + i ) ) );
+
+    const auto hi2 = vpmax_f32( vget_low_f32( hi ), vget_high_f32( hi ) );
+    return scalar::peak( src + i, n - i, vget_lane_f32( vpmax_f32( hi2, hi2 ), 0 ) );
+}
+
+inline auto find_above( const float* src, size_t n, float threshold ) -> size_t
+{
+    const auto limit = vdupq_n_f32( threshold );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto above = vcgtq_f32( vabsq_f32( vld1q_f32( src + i ) ), limit );
+        const auto any   = vorr_u32( vget_low_u32( above ), vget_high_u32( above ) );
+        if ( ( vget_lane_u32( any, 0 ) | vget_lane_u32( any, 1 ) ) != 0 )
+            break;
+    }
+
+    return i + scalar::find_above( src + i, n - i, threshold );
+}
+
+// triangular dither, one xorshift32 generator per lane
+
+inline uint32x4_t xorshift( uint32x4_t& x )
+{
+    x = veorq_u32( x, vshlq_n_u32( x, 13 ) );
+    x = veorq_u32( x, vshrq_n_u32( x, 17 ) );
+    x = veorq_u32( x, vshlq_n_u32( x, 5 ) );
+    return x;
+}
+
+inline float32x4_t uniform( uint32x4_t x )
+{
+    const auto one = vreinterpretq_f32_u32( vorrq_u32( vshrq_n_u32( x, 9 ), vdupq_n_u32( 0x3f800000u ) ) );
+    return vsubq_f32( one, vdupq_n_f32( 1.f ) );
+}
+
+inline float32x4_t triangular( uint32x4_t& state, float lsb )
+{
+    const auto a = uniform( xorshift( state ) );
+    const auto b = uniform( xorshift( state ) );
+    return vmulq_n_f32( vsubq_f32( a, b ), lsb );
+}
+
+// clamp, round half away from zero to a multiple of lsb. nan clamps to -1 like the scalar kernel.
+inline float32x4_t quantize( float32x4_t x, float lsb )
+{
+    const auto lo      = vdupq_n_f32( -1.f );
+    const auto hi      = vdupq_n_f32( 1.f - lsb );
+    const auto above   = vbslq_f32( vcgtq_f32( x, lo ), x, lo );
+    const auto clamped = vbslq_f32( vcltq_f32( above, hi ), above, hi );
+    const auto scaled  = vmulq_n_f32( clamped, 1.f / lsb );
+    const auto sign    = vandq_u32( vreinterpretq_u32_f32( scaled ), vdupq_n_u32( 0x80000000u ) );
+    const auto half    = vreinterpretq_f32_u32( vorrq_u32( sign, vreinterpretq_u32_f32( vdupq_n_f32( 0.5f ) ) ) );
+    return vmulq_n_f32( vcvtq_f32_s32( vcvtq_s32_f32( vaddq_f32( scaled, half ) ) ), lsb );
+}
+
+inline void noise( size_t n, float lsb, uint32_t* state, float* dst )
+{
+    auto lanes = vld1q_u32( state );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        vst1q_f32( dst + i, triangular( lanes, lsb ) );
+
+    vst1q_u32( state, lanes );
+    scalar::noise( n - i, lsb, state, dst + i );
+}
+
+inline void tpdf( const float* src, size_t n, float lsb, uint32_t* state, float* dst )
+{
+    auto lanes = vld1q_u32( state );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        vst1q_f32( dst + i, quantize( vaddq_f32( vld1q_f32( src + i ), triangular( lanes, lsb ) ), lsb ) );
+
+    vst1q_u32( state, lanes );
+    scalar::tpdf( src + i, n - i, lsb, state, dst + i );
+}
+
+} // namespace neon
+} // namespace detail
+} // namespace pcm
+
+#endif
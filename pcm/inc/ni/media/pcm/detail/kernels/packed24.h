@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/compiletime_format.h>
+#include <ni/media/pcm/detail/kernels/byteswap.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+namespace packed24
+{
+
+// Packed 24 bit samples are moved with unaligned 32 bit word accesses instead of single bytes.
+// Samples are returned aligned to the upper 24 bits of a 32 bit word, which is how
+// intermediate<Format> stores them, so the results can be passed on to convert_to.
+
+// 4 bytes interpreted in byte order e
+template <endian_type e>
+uint32_t load_word( const char* src )
+{
+    uint32_t word;
+    std::memcpy( &word, src, sizeof( word ) );
+    return e == native_endian ? word : byteswap( word );
+}
+
+template <endian_type e>
+void store_word( char* dst, uint32_t word )
+{
+    word = e == native_endian ? word : byteswap( word );
+    std::memcpy( dst, &word, sizeof( word ) );
+}
+
+template <endian_type e>
+uint32_t load( const char* src )
+{
+    const auto b0 = uint32_t( uint8_t( src[0] ) );
+    const auto b1 = uint32_t( uint8_t( src[1] ) );
+    const auto b2 = uint32_t( uint8_t( src[2] ) );
+    return e == little_endian ? ( b0 << 8 ) | ( b1 << 16 ) | ( b2 << 24 ) : ( b0 << 24 ) | ( b1 << 16 ) | ( b2 << 8 );
+}
+
+template <endian_type e>
+void store( char* dst, uint32_t sample )
+{
+    const auto lo  = char( sample >> 8 );
+    const auto mid = char( sample >> 16 );
+    const auto hi  = char( sample >> 24 );
+    dst[0]         = e == little_endian ? lo : hi;
+    dst[1]         = mid;
+    dst[2]         = e == little_endian ? hi : lo;
+}
+
+// 4 samples from a group of 12 bytes, with three word loads
+
+inline void load4( const char* src, uint32_t ( &samples )[4], std::integral_constant<endian_type, little_endian> )
+{
+    const auto w0 = load_word<little_endian>( src );
+    const auto w1 = load_word<little_endian>( src + 4 );
+    const auto w2 = load_word<little_endian>( src + 8 );
+
+    samples[0] = w0 << 8;
+    samples[1] = ( ( w0 >> 24 ) << 8 ) | ( w1 << 16 );
+    samples[2] = ( ( w1 >> 16 ) << 8 ) | ( w2 << 24 );
+    samples[3] = w2 & 0xffffff00u;
+}
+
+inline void load4( const char* src, uint32_t ( &samples )[4], std::integral_constant<endian_type, big_endian> )
+{
+    const auto w0 = load_word<big_endian>( src );
+    const auto w1 = load_word<big_endian>( src + 4 );
+    const auto w2 = load_word<big_endian>( src + 8 );
+
+    samples[0] = w0 & 0xffffff00u;
+    samples[1] = ( w0 << 24 ) | ( ( w1 >> 8 ) & 0x00ffff00u );
+    samples[2] = ( w1 << 16 ) | ( ( w2 >> 16 ) & 0x0000ff00u );
+    samples[3] = w2 << 8;
+}
+
+template <endian_type e>
+void load4( const char* src, uint32_t ( &samples )[4] )
+{
+    load4( src, samples, std::integral_constant<endian_type, e>{} );
+}
+
+// 4 samples to a group of 12 bytes, with three word stores
+
+inline void store4( char* dst, const uint32_t ( &samples )[4], std::integral_constant<endian_type, little_endian> )
+{
+    store_word<little_endian>( dst, ( samples[0] >> 8 ) | ( samples[1] << 16 & 0xff000000u ) );
+    store_word<little_endian>( dst + 4, ( samples[1] >> 16 ) | ( samples[2] << 8 & 0xffff0000u ) );
+    store_word<little_endian>( dst + 8, ( samples[2] >> 24 ) | ( samples[3] & 0xffffff00u ) );
+}
+
+inline void store4( char* dst, const uint32_t ( &samples )[4], std::integral_constant<endian_type, big_endian> )
+{
+    store_word<big_endian>( dst, ( samples[0] & 0xffffff00u ) | ( samples[1] >> 24 ) );
+    store_word<big_endian>( dst + 4, ( samples[1] << 8 & 0xffff0000u ) | ( samples[2] >> 16 ) );
+    store_word<big_endian>( dst + 8, ( samples[2] << 16 & 0xff000000u ) | ( samples[3] >> 8 ) );
+}
+
+template <endian_type e>
+void store4( char* dst, const uint32_t ( &samples )[4] )
+{
+    store4( dst, samples, std::integral_constant<endian_type, e>{} );
+}
+
+} // namespace packed24
+} // namespace detail
+} // namespace pcm
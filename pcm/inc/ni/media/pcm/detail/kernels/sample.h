@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/detail/kernels/byteswap.h>
+#include <ni/media/pcm/detail/kernels/packed24.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+// loads and stores single samples as the storage type of their format, see intermediate<Format>
+
+template <size_t bytes>
+using word_t = std::conditional_t<bytes == 1,
+                                  uint8_t,
+                                  std::conditional_t<bytes == 2, uint16_t, std::conditional_t<bytes == 4, uint32_t, uint64_t>>>;
+
+struct word_sample
+{
+};
+
+struct packed24_sample
+{
+};
+
+struct companded_sample
+{
+};
+
+struct half_sample
+{
+};
+
+template <class Format>
+using sample_layout_t = std::conditional_t<
+    is_companded<Format{}.number()>::value,
+    companded_sample,
+    std::conditional_t<is_half<Format>::value,
+                       half_sample,
+                       std::conditional_t<Format{}.bitwidth() == 24, packed24_sample, word_sample>>>;
+
+template <class Format>
+auto load_sample( const char* src, word_sample )
+{
+    using storage_type = typename storage<Format>::type;
+    using word_type    = word_t<sizeof( storage_type )>;
+
+    word_type word;
+    std::memcpy( &word, src, sizeof( word ) );
+    if ( Format{}.endian() != native_endian )
+        word = byteswap( word );
+
+    storage_type value;
+    std::memcpy( &value, &word, sizeof( value ) );
+    return value;
+}
+
+template <class Format>
+auto load_sample( const char* src, packed24_sample )
+{
+    using storage_type = typename storage<Format>::type;
+    return storage_type( packed24::load<Format{}.endian()>( src ) );
+}
+
+template <class Format>
+auto load_sample( const char* src, companded_sample )
+{
+    return g711::decode( static_cast<uint8_t>( *src ), number_t<Format{}.number()>{} );
+}
+
+template <class Format>
+auto load_sample( const char* src, half_sample )
+{
+    uint16_t word;
+    std::memcpy( &word, src, sizeof( word ) );
+    if ( Format{}.endian() != native_endian )
+        word = byteswap( word );
+
+    return binary16::decode( word );
+}
+
+template <class Format>
+auto load_sample( const char* src )
+{
+    return clear_padding<Format>( load_sample<Format>( src, sample_layout_t<Format>{} ) );
+}
+
+template <class Format>
+void store_sample( char* dst, typename storage<Format>::type value, word_sample )
+{
+    using word_type = word_t<sizeof( value )>;
+
+    word_type word;
+    std::memcpy( &word, &value, sizeof( word ) );
+    if ( Format{}.endian() != native_endian )
+        word = byteswap( word );
+
+    std::memcpy( dst, &word, sizeof( word ) );
+}
+
+template <class Format>
+void store_sample( char* dst, typename storage<Format>::type value, packed24_sample )
+{
+    packed24::store<Format{}.endian()>( dst, uint32_t( value ) );
+}
+
+template <class Format>
+void store_sample( char* dst, typename storage<Format>::type value, companded_sample )
+{
+    *dst = static_cast<char>( g711::encode( value, number_t<Format{}.number()>{} ) );
+}
+
+template <class Format>
+void store_sample( char* dst, typename storage<Format>::type value, half_sample )
+{
+    auto word = binary16::encode( value );
+    if ( Format{}.endian() != native_endian )
+        word = byteswap( word );
+
+    std::memcpy( dst, &word, sizeof( word ) );
+}
+
+template <class Format>
+void store_sample( char* dst, typename storage<Format>::type value )
+{
+    store_sample<Format>( dst, clear_padding<Format>( value ), sample_layout_t<Format>{} );
+}
+
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/detail/kernels/packed24.h>
+#include <ni/media/pcm/detail/kernels/sample.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace pcm
+{
+namespace detail
+{
+
+template <class Value>
+using read_kernel_t = void ( * )( const char*, size_t, Value* );
+
+template <class Value>
+using write_kernel_t = void ( * )( const Value*, size_t, char* );
+
+// scatters frames of interleaved values to dst[channel][offset, offset + frames)
+template <class Value>
+using deinterleave_kernel_t = void ( * )( const Value*, size_t, size_t, Value* const*, size_t );
+
+// gathers src[channel][offset, offset + frames) to frames of interleaved values
+template <class Value>
+using interleave_kernel_t = void ( * )( const Value* const*, size_t, size_t, size_t, Value* );
+
+// mixes frames of in_channels values to frames of out_channels values,
+// dst[out] = sum over in of matrix[out * in_channels + in] * src[in]
+template <class Value>
+using mix_kernel_t = void ( * )( const Value*, size_t, size_t, size_t, const Value*, Value* );
+
+// block reductions behind the analysis algorithms, each one continues from the result of the previous block
+template <class Value>
+struct reduce_kernels_t
+{
+    std::pair<Value, Value> ( *min_max )( const Value*, size_t, std::pair<Value, Value> );
+    Value ( *peak )( const Value*, size_t, Value );
+    double ( *sum )( const Value*, size_t, double );
+    double ( *sum_of_squares )( const Value*, size_t, double );
+
+    // index of the first value with a magnitude above the threshold, n if there is none
+    size_t ( *find_above )( const Value*, size_t, Value );
+};
+
+// triangular dither for float to integer conversion, lsb is the step of the target format
+template <class Value>
+struct dither_kernels_t
+{
+    // n values of triangular noise within +-lsb
+    void ( *noise )( size_t, Value, uint32_t*, Value* );
+
+    // adds triangular noise, clamps to [-1, 1 - lsb] and rounds half away from zero to a multiple of lsb
+    void ( *tpdf )( const Value*, size_t, Value, uint32_t*, Value* );
+};
+
+// the generator state is one xorshift32 word per lane, value i draws from lane i % dither_lanes.
+// simd kernels advance all lanes at once and produce the same sequence as the scalar ones.
+constexpr size_t dither_lanes = 4;
+
+// the samples are stored bit-identically as Value, no conversion needed
+template <class Value, class Format>
+using is_identity_format = std::integral_constant<bool,
+                                                  std::is_same<Value, typename storage<Format>::type>::value
+                                                      && Format{}.endian() == native_endian
+                                                      && Format{}.bitwidth() == sizeof( Value ) * 8
+                                                      && !is_padded<Format>::value>;
+
+namespace scalar
+{
+
+template <class Value, class Format>
+void read_n( const char* src, size_t n, Value* dst, std::true_type /*identity*/ )
+{
+    if ( n > 0 )
+        std::memcpy( dst, src, n * sizeof( Value ) );
+}
+
+template <class Value, class Format, int bits>
+void read_samples( const char* src, size_t n, Value* dst, std::integral_constant<int, bits> )
+{
+    constexpr auto step = bits / 8;
+
+    for ( size_t i = 0; i < n; ++i, src += step )
+        dst[i] = convert_to<Value>( load_sample<Format>( src ) );
+}
+
+template <class Value, class Format>
+void read_samples( const char* src, size_t n, Value* dst, std::integral_constant<int, 24> )
+{
+    using storage_type = typename storage<Format>::type;
+
+    constexpr auto e = Format{}.endian();
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4, src += 12 )
+    {
+        uint32_t samples[4];
+        packed24::load4<e>( src, samples );
+        for ( size_t k = 0; k < 4; ++k )
+            dst[i + k] = convert_to<Value>( clear_padding<Format>( storage_type( samples[k] ) ) );
+    }
+
+    for ( ; i < n; ++i, src += 3 )
+        dst[i] = convert_to<Value>( clear_padding<Format>( storage_type( packed24::load<e>( src ) ) ) );
+}
+
+template <class Value, class Format>
+void read_n( const char* src, size_t n, Value* dst, std::false_type /*identity*/ )
+{
+    read_samples<Value, Format>( src, n, dst, std::integral_constant<int, Format{}.bitwidth()>{} );
+}
+
+template <class Value, class Format>
+void write_n( const Value* src, size_t n, char* dst, std::true_type /*identity*/ )
+{
+    if ( n > 0 )
+        std::memcpy( dst, src, n * sizeof( Value ) );
+}
+
+template <class Value, class Format, int bits>
+void write_samples( const Value* src, size_t n, char* dst, std::integral_constant<int, bits> )
+{
+    using storage_type = typename storage<Format>::type;
+
+    constexpr auto step = bits / 8;
+
+    for ( size_t i = 0; i < n; ++i, dst += step )
+        store_sample<Format>( dst, convert_to<storage_type>( src[i] ) );
+}
+
+template <class Value, class Format>
+void write_samples( const Value* src, size_t n, char* dst, std::integral_constant<int, 24> )
+{
+    using storage_type = typename storage<Format>::type;
+
+    constexpr auto e = Format{}.endian();
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4, dst += 12 )
+    {
+        uint32_t samples[4];
+        for ( size_t k = 0; k < 4; ++k )
+            samples[k] = uint32_t( clear_padding<Format>( convert_to<storage_type>( src[i + k] ) ) );
+        packed24::store4<e>( dst, samples );
+    }
+
+    for ( ; i < n; ++i, dst += 3 )
+        packed24::store<e>( dst, uint32_t( clear_padding<Format>( convert_to<storage_type>( src[i] ) ) ) );
+}
+
+template <class Value, class Format>
+void write_n( const Value* src, size_t n, char* dst, std::false_type /*identity*/ )
+{
+    write_samples<Value, Format>( src, n, dst, std::integral_constant<int, Format{}.bitwidth()>{} );
+}
+
+template <class Value, class Format>
+void read( const char* src, size_t n, Value* dst )
+{
+    read_n<Value, Format>( src, n, dst, is_identity_format<Value, Format>{} );
+}
+
+template <class Value, class Format>
+void write( const Value* src, size_t n, char* dst )
+{
+    write_n<Value, Format>( src, n, dst, is_identity_format<Value, Format>{} );
+}
+
+template <class Value>
+void deinterleave( const Value* src, size_t frames, size_t channels, Value* const* dst, size_t offset )
+{
+    for ( size_t c = 0; c < channels; ++c )
+    {
+        auto out = dst[c] + offset;
+        for ( size_t f = 0; f < frames; ++f )
+            out[f] = src[f * channels + c];
+    }
+}
+
+template <class Value>
+void interleave( const Value* const* src, size_t offset, size_t frames, size_t channels, Value* dst )
+{
+    for ( size_t c = 0; c < channels; ++c )
+    {
+        auto in = src[c] + offset;
+        for ( size_t f = 0; f < frames; ++f )
+            dst[f * channels + c] = in[f];
+    }
+}
+
+template <class Value>
+void mix( const Value* src, size_t frames, size_t in_channels, size_t out_channels, const Value* matrix, Value* dst )
+{
+    for ( size_t f = 0; f < frames; ++f, src += in_channels, dst += out_channels )
+    {
+        for ( size_t o = 0; o < out_channels; ++o )
+        {
+            const auto row = matrix + o * in_channels;
+
+            auto sum = row[0] * src[0];
+            for ( size_t i = 1; i < in_channels; ++i )
+                sum += row[i] * src[i];
+            dst[o] = sum;
+        }
+    }
+}
+
+// the channel counts are known at compile time, so the compiler unrolls the frame
+template <class Value, size_t in_channels, size_t out_channels>
+void mix_fixed( const Value* src, size_t frames, size_t, size_t, const Value* matrix, Value* dst )
+{
+    Value m[out_channels * in_channels];
+    std::copy( matrix, matrix + out_channels * in_channels, m );
+
+    for ( size_t f = 0; f < frames; ++f, src += in_channels, dst += out_channels )
+    {
+        for ( size_t o = 0; o < out_channels; ++o )
+        {
+            auto sum = m[o * in_channels] * src[0];
+            for ( size_t i = 1; i < in_channels; ++i )
+                sum += m[o * in_channels + i] * src[i];
+            dst[o] = sum;
+        }
+    }
+}
+
+// a mix_kernel_t with one gain per channel instead of a matrix, in_channels == out_channels
+template <class Value>
+void scale( const Value* src, size_t frames, size_t channels, size_t, const Value* gains, Value* dst )
+{
+    for ( size_t f = 0; f < frames; ++f, src += channels, dst += channels )
+        for ( size_t c = 0; c < channels; ++c )
+            dst[c] = gains[c] * src[c];
+}
+
+template <class Value>
+auto min_max( const Value* src, size_t n, std::pair<Value, Value> result ) -> std::pair<Value, Value>
+{
+    for ( size_t i = 0; i < n; ++i )
+    {
+        result.first  = std::min( result.first, src[i] );
+        result.second = std::max( result.second, src[i] );
+    }
+    return result;
+}
+
+template <class Value>
+auto peak( const Value* src, size_t n, Value result ) -> Value
+{
+    for ( size_t i = 0; i < n; ++i )
+        result = std::max( result, std::abs( src[i] ) );
+    return result;
+}
+
+// four partial sums hide the latency of the additions
+template <class Value>
+auto sum( const Value* src, size_t n, double result ) -> double
+{
+    double partial[4] = {};
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        for ( size_t k = 0; k < 4; ++k )
+            partial[k] += double( src[i + k] );
+
+    for ( ; i < n; ++i )
+        result += double( src[i] );
+
+    return result + ( ( partial[0] + partial[1] ) + ( partial[2] + partial[3] ) );
+}
+
+template <class Value>
+auto sum_of_squares( const Value* src, size_t n, double result ) -> double
+{
+    double partial[4] = {};
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        for ( size_t k = 0; k < 4; ++k )
+            partial[k] += double( src[i + k] ) * double( src[i + k] );
+
+    for ( ; i < n; ++i )
+        result += double( src[i] ) * double( src[i] );
+
+    return result + ( ( partial[0] + partial[1] ) + ( partial[2] + partial[3] ) );
+}
+
+template <class Value>
+auto find_above( const Value* src, size_t n, Value threshold ) -> size_t
+{
+    for ( size_t i = 0; i < n; ++i )
+        if ( std::abs( src[i] ) > threshold )
+            return i;
+    return n;
+}
+
+inline auto xorshift( uint32_t& x ) -> uint32_t
+{
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// uniform in [0, 1) from the upper 23 bits
+inline auto uniform( uint32_t x ) -> float
+{
+    const uint32_t bits = ( x >> 9 ) | 0x3f800000u;
+    float          result;
+    std::memcpy( &result, &bits, sizeof( result ) );
+    return result - 1.f;
+}
+
+// the difference of two uniform values is exact in float
+template <class Value>
+auto triangular( uint32_t& state, Value lsb ) -> Value
+{
+    const auto a = uniform( xorshift( state ) );
+    const auto b = uniform( xorshift( state ) );
+    return Value( a - b ) * lsb;
+}
+
+// nan clamps to -1 like the simd min / max instructions
+template <class Value>
+auto quantize( Value val, Value lsb ) -> Value
+{
+    const auto lo = Value{-1};
+    const auto hi = Value{1} - lsb;
+
+    val               = val > lo ? val : lo;
+    val               = val < hi ? val : hi;
+    const auto scaled = val * ( Value{1} / lsb );
+    return Value( int32_t( scaled + std::copysign( Value{0.5}, scaled ) ) ) * lsb;
+}
+
+template <class Value>
+void noise( size_t n, Value lsb, uint32_t* state, Value* dst )
+{
+    for ( size_t i = 0; i < n; ++i )
+        dst[i] = triangular( state[i % dither_lanes], lsb );
+}
+
+template <class Value>
+void tpdf( const Value* src, size_t n, Value lsb, uint32_t* state, Value* dst )
+{
+    for ( size_t i = 0; i < n; ++i )
+        dst[i] = quantize( src[i] + triangular( state[i % dither_lanes], lsb ), lsb );
+}
+
+} // namespace scalar
+} // namespace detail
+} // namespace pcm
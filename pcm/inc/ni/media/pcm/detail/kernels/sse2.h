@@ -0,0 +1,777 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/cpu.h>
+
+#if NIMEDIA_PCM_SIMD_X86
+
+#include <ni/media/pcm/detail/kernels/packed24.h>
+#include <ni/media/pcm/detail/kernels/scalar.h>
+#include <ni/media/pcm/detail/kernels/traits.h>
+#include <ni/media/pcm/detail/kernels/transcode.h>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace pcm
+{
+namespace detail
+{
+namespace sse2
+{
+
+// reverses the bytes of each 16, 32 or 64 bit lane, sse2 has no byte shuffle
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i byteswap( __m128i x, bits_t<16> )
+{
+    return _mm_or_si128( _mm_slli_epi16( x, 8 ), _mm_srli_epi16( x, 8 ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i byteswap( __m128i x, bits_t<32> )
+{
+    const auto words = _mm_shufflehi_epi16( _mm_shufflelo_epi16( x, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    return byteswap( words, bits_t<16>{} );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i byteswap( __m128i x, bits_t<64> )
+{
+    const auto words = _mm_shufflehi_epi16( _mm_shufflelo_epi16( x, _MM_SHUFFLE( 0, 1, 2, 3 ) ), _MM_SHUFFLE( 0, 1, 2, 3 ) );
+    return byteswap( words, bits_t<16>{} );
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i to_native( __m128i x, bits_t<bits>, std::true_type /*is_native*/ )
+{
+    return x;
+}
+
+template <int bits>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i to_native( __m128i x, bits_t<bits> b, std::false_type /*is_native*/ )
+{
+    return byteswap( x, b );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i load( const char* src )
+{
+    return _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+}
+
+// loads 4 samples into the upper bits of 32 bit lanes
+
+template <class Format>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i load_top_aligned( const char* src, bits_t<8> )
+{
+    int32_t word;
+    std::memcpy( &word, src, sizeof( word ) );
+    const auto zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16( zero, _mm_unpacklo_epi8( zero, _mm_cvtsi32_si128( word ) ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i load_top_aligned( const char* src, bits_t<16> )
+{
+    const auto words = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( src ) );
+    return _mm_unpacklo_epi16( _mm_setzero_si128(), to_native( words, bits_t<16>{}, is_native_format<Format>{} ) );
+}
+
+// the 12 byte group is split with word loads and shifts
+template <class Format>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i load_top_aligned( const char* src, bits_t<24> )
+{
+    uint32_t samples[4];
+    packed24::load4<Format{}.endian()>( src, samples );
+    return _mm_loadu_si128( reinterpret_cast<const __m128i*>( samples ) );
+}
+
+template <class Format>
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i load_top_aligned( const char* src, bits_t<32> )
+{
+    return to_native( load( src ), bits_t<32>{}, is_native_format<Format>{} );
+}
+
+// loads 4 byte swapped floating point samples and stores them as Value
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_swapped_real( float* dst, const char* src, bits_t<32> )
+{
+    _mm_storeu_ps( dst, _mm_castsi128_ps( byteswap( load( src ), bits_t<32>{} ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_swapped_real( double* dst, const char* src, bits_t<32> )
+{
+    const auto samples = _mm_castsi128_ps( byteswap( load( src ), bits_t<32>{} ) );
+    _mm_storeu_pd( dst, _mm_cvtps_pd( samples ) );
+    _mm_storeu_pd( dst + 2, _mm_cvtps_pd( _mm_movehl_ps( samples, samples ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_swapped_real( float* dst, const char* src, bits_t<64> )
+{
+    const auto lo = _mm_cvtpd_ps( _mm_castsi128_pd( byteswap( load( src ), bits_t<64>{} ) ) );
+    const auto hi = _mm_cvtpd_ps( _mm_castsi128_pd( byteswap( load( src + 16 ), bits_t<64>{} ) ) );
+    _mm_storeu_ps( dst, _mm_movelh_ps( lo, hi ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_swapped_real( double* dst, const char* src, bits_t<64> )
+{
+    _mm_storeu_pd( dst, _mm_castsi128_pd( byteswap( load( src ), bits_t<64>{} ) ) );
+    _mm_storeu_pd( dst + 2, _mm_castsi128_pd( byteswap( load( src + 16 ), bits_t<64>{} ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_real( float* dst, __m128i top_aligned, float scale )
+{
+    _mm_storeu_ps( dst, _mm_mul_ps( _mm_cvtepi32_ps( top_aligned ), _mm_set1_ps( scale ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_real( double* dst, __m128i top_aligned, double scale )
+{
+    const auto hi = _mm_shuffle_epi32( top_aligned, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    _mm_storeu_pd( dst, _mm_mul_pd( _mm_cvtepi32_pd( top_aligned ), _mm_set1_pd( scale ) ) );
+    _mm_storeu_pd( dst + 2, _mm_mul_pd( _mm_cvtepi32_pd( hi ), _mm_set1_pd( scale ) ) );
+}
+
+// clamp, upscale and round half away from zero, exactly like convert_to
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i quantize( const float* src, __m128 scale, __m128 max )
+{
+    const auto clamped = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src ), _mm_set1_ps( -1.f ) ), max );
+    const auto scaled  = _mm_mul_ps( clamped, scale );
+    const auto half    = _mm_or_ps( _mm_and_ps( scaled, _mm_set1_ps( -0.f ) ), _mm_set1_ps( 0.5f ) );
+    return _mm_cvttps_epi32( _mm_add_ps( scaled, half ) );
+}
+
+// quantizes and stores 16 bytes of samples, 12 bytes for 24 bit
+
+NIMEDIA_PCM_TARGET_SSE2
+inline void store_quantized(
+    char* dst, const float* src, __m128 scale, __m128 max, __m128i flip, __m128i /*mask*/, bits_t<8> )
+{
+    const auto lo = _mm_packs_epi32( quantize( src, scale, max ), quantize( src + 4, scale, max ) );
+    const auto hi = _mm_packs_epi32( quantize( src + 8, scale, max ), quantize( src + 12, scale, max ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_xor_si128( _mm_packs_epi16( lo, hi ), flip ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2
+inline void store_quantized(
+    char* dst, const float* src, __m128 scale, __m128 max, __m128i flip, __m128i mask, bits_t<16> )
+{
+    const auto packed = _mm_packs_epi32( quantize( src, scale, max ), quantize( src + 4, scale, max ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_and_si128( _mm_xor_si128( packed, flip ), mask ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2
+inline void store_quantized(
+    char* dst, const float* src, __m128 scale, __m128 max, __m128i flip, __m128i mask, bits_t<24> )
+{
+    const auto quantized = _mm_xor_si128( quantize( src, scale, max ), flip );
+
+    uint32_t samples[4];
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( samples ), _mm_and_si128( quantized, mask ) );
+    packed24::store4<native_endian>( dst, samples );
+}
+
+NIMEDIA_PCM_TARGET_SSE2
+inline void store_quantized(
+    char* dst, const float* src, __m128 scale, __m128 max, __m128i flip, __m128i mask, bits_t<32> )
+{
+    const auto quantized = _mm_xor_si128( quantize( src, scale, max ), flip );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_and_si128( quantized, mask ) );
+}
+
+// G.711 encoding of 8 linear 16 bit samples. The segment counts the segment ends below the sample,
+// the mantissa shift grows by one with every segment end passed.
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i select( __m128i mask, __m128i a, __m128i b )
+{
+    return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i encode( __m128i linear, number_t<alaw> )
+{
+    const auto sign = _mm_srai_epi16( linear, 15 );
+    const auto val  = _mm_xor_si128( _mm_srai_epi16( linear, 3 ), sign ); // -val - 1 for negative samples
+
+    auto seg      = _mm_setzero_si128();
+    auto mantissa = _mm_srli_epi16( val, 1 );
+    for ( int k = 0; k < 8; ++k )
+    {
+        const auto above = _mm_cmpgt_epi16( val, _mm_set1_epi16( g711::alaw_segment_ends[k] ) );
+        seg              = _mm_sub_epi16( seg, above );
+        if ( k > 0 )
+            mantissa = select( above, _mm_srli_epi16( mantissa, 1 ), mantissa );
+    }
+
+    const auto code = _mm_or_si128( _mm_slli_epi16( seg, 4 ), _mm_and_si128( mantissa, _mm_set1_epi16( 0x0f ) ) );
+    const auto mask = _mm_xor_si128( _mm_set1_epi16( 0xd5 ), _mm_and_si128( sign, _mm_set1_epi16( 0x80 ) ) );
+    return _mm_xor_si128( code, mask );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i encode( __m128i linear, number_t<ulaw> )
+{
+    const auto sign = _mm_srai_epi16( linear, 15 );
+    const auto mag  = _mm_sub_epi16( _mm_xor_si128( _mm_srai_epi16( linear, 2 ), sign ), sign );
+    const auto val  = _mm_add_epi16( _mm_min_epi16( mag, _mm_set1_epi16( g711::ulaw_clip ) ),
+                                    _mm_set1_epi16( g711::ulaw_bias >> 2 ) );
+
+    auto seg      = _mm_setzero_si128();
+    auto mantissa = _mm_srli_epi16( val, 1 );
+    auto above    = _mm_setzero_si128();
+    for ( int k = 0; k < 8; ++k )
+    {
+        above    = _mm_cmpgt_epi16( val, _mm_set1_epi16( g711::ulaw_segment_ends[k] ) );
+        seg      = _mm_sub_epi16( seg, above );
+        mantissa = select( above, _mm_srli_epi16( mantissa, 1 ), mantissa );
+    }
+
+    // beyond the last segment the code saturates
+    const auto code = select( above,
+                              _mm_set1_epi16( 0x7f ),
+                              _mm_or_si128( _mm_slli_epi16( seg, 4 ),
+                                            _mm_and_si128( mantissa, _mm_set1_epi16( 0x0f ) ) ) );
+    const auto mask = _mm_xor_si128( _mm_set1_epi16( 0xff ), _mm_and_si128( sign, _mm_set1_epi16( 0x80 ) ) );
+    return _mm_xor_si128( code, mask );
+}
+
+// G.711 decoding of 4 codes in 32 bit lanes straight to float, both subtractions are exact
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 decode( __m128i codes, number_t<alaw> )
+{
+    const auto x    = _mm_xor_si128( codes, _mm_set1_epi32( 0x55 ) );
+    const auto s    = _mm_and_si128( x, _mm_set1_epi32( 0x7f ) );
+    const auto seg0 = _mm_cmplt_epi32( s, _mm_set1_epi32( 0x10 ) );
+
+    const auto s1   = _mm_or_si128( s, _mm_and_si128( seg0, _mm_set1_epi32( 0x10 ) ) );
+    const auto bits = _mm_add_epi32( _mm_slli_epi32( s1, 19 ), _mm_set1_epi32( g711::float_bits ) );
+    const auto mag  = _mm_sub_ps( _mm_castsi128_ps( bits ),
+                                 _mm_and_ps( _mm_castsi128_ps( seg0 ), _mm_set1_ps( 1.f / 128 ) ) );
+
+    const auto sign = _mm_slli_epi32( _mm_andnot_si128( x, _mm_set1_epi32( 0x80 ) ), 24 );
+    return _mm_or_ps( mag, _mm_castsi128_ps( sign ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 decode( __m128i codes, number_t<ulaw> )
+{
+    const auto x    = _mm_xor_si128( codes, _mm_set1_epi32( 0xff ) );
+    const auto bits = _mm_add_epi32( _mm_slli_epi32( _mm_and_si128( x, _mm_set1_epi32( 0x7f ) ), 19 ),
+                                     _mm_set1_epi32( g711::float_bits ) );
+
+    // -t + bias instead of -(t - bias), zero stays positive
+    const auto sign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( x, _mm_set1_epi32( 0x80 ) ), 24 ) );
+    const auto bias = _mm_set1_ps( float( g711::ulaw_bias ) / 32768 );
+    return _mm_sub_ps( _mm_or_ps( _mm_castsi128_ps( bits ), sign ), _mm_or_ps( bias, sign ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_real( float* dst, __m128 samples )
+{
+    _mm_storeu_ps( dst, samples );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void store_real( double* dst, __m128 samples )
+{
+    _mm_storeu_pd( dst, _mm_cvtps_pd( samples ) );
+    _mm_storeu_pd( dst + 2, _mm_cvtps_pd( _mm_movehl_ps( samples, samples ) ) );
+}
+
+struct kernels
+{
+    template <class Value, class Format>
+    using can_read = std::integral_constant<bool,
+                                            std::is_floating_point<Value>::value
+                                                && ( is_simd_integer_format<Format>::value
+                                                     || is_simd_swapped_format<Format>::value
+                                                     || is_companded_format<Format>::value )>;
+
+    template <class Value, class Format>
+    using can_write = std::integral_constant<bool,
+                                             std::is_same<Value, float>::value
+                                                 && ( is_simd_integer_format<Format>::value
+                                                      || is_companded_format<Format>::value )>;
+
+    // 24 bit is left to the packed24 groups of the scalar kernel
+    template <class Source, class Target>
+    using can_byteswap = std::integral_constant<bool,
+                                                kernel_traits<Source>::bits == 16 || kernel_traits<Source>::bits == 32
+                                                    || kernel_traits<Source>::bits == 64>;
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void read( const char* src, size_t n, Value* dst, std::true_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        const auto flip  = _mm_set1_epi32( traits::read_flip );
+        const auto mask  = _mm_set1_epi32( traits::read_mask );
+        const auto scale = traits::template read_scale<Value>();
+
+        size_t i = 0;
+        for ( ; i + 4 <= n; i += 4, src += 4 * traits::bytes, dst += 4 )
+        {
+            const auto samples = _mm_xor_si128( load_top_aligned<Format>( src, bits_t<traits::bits>{} ), flip );
+            store_real( dst, _mm_and_si128( samples, mask ), scale );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void read( const char* src, size_t n, Value* dst, std::false_type /*is_integer*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        size_t i = 0;
+        for ( ; i + 4 <= n; i += 4, src += 4 * traits::bytes, dst += 4 )
+            store_swapped_real( dst, src, bits_t<traits::bits>{} );
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void read_n( const char* src, size_t n, Value* dst, std::false_type /*is_companded*/ )
+    {
+        read<Value, Format>( src, n, dst, is_integer_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void read_n( const char* src, size_t n, Value* dst, std::true_type /*is_companded*/ )
+    {
+        using number = number_t<Format{}.number()>;
+
+        const auto zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for ( ; i + 16 <= n; i += 16, src += 16, dst += 16 )
+        {
+            const auto codes = load( src );
+            const auto lo    = _mm_unpacklo_epi8( codes, zero );
+            const auto hi    = _mm_unpackhi_epi8( codes, zero );
+            store_real( dst, decode( _mm_unpacklo_epi16( lo, zero ), number{} ) );
+            store_real( dst + 4, decode( _mm_unpackhi_epi16( lo, zero ), number{} ) );
+            store_real( dst + 8, decode( _mm_unpacklo_epi16( hi, zero ), number{} ) );
+            store_real( dst + 12, decode( _mm_unpackhi_epi16( hi, zero ), number{} ) );
+        }
+
+        scalar::read<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void read( const char* src, size_t n, Value* dst )
+    {
+        read_n<Value, Format>( src, n, dst, is_companded_format<Format>{} );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void write( const Value* src, size_t n, char* dst, std::false_type /*is_companded*/ )
+    {
+        using traits = kernel_traits<Format>;
+
+        constexpr size_t block = traits::bits == 24 ? 4 : 16 / traits::bytes;
+
+        const auto flip  = _mm_set1_epi32( traits::write_flip );
+        const auto mask  = _mm_set1_epi32( traits::write_mask );
+        const auto scale = _mm_set1_ps( traits::template write_scale<float>() );
+        const auto max   = _mm_set1_ps( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += block, dst += block * traits::bytes )
+            store_quantized( dst, src, scale, max, flip, mask, bits_t<traits::bits>{} );
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    // quantized to 16 bit like convert_to<int16_t>, then encoded
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void write( const Value* src, size_t n, char* dst, std::true_type /*is_companded*/ )
+    {
+        using traits = kernel_traits<Format>;
+        using number = number_t<Format{}.number()>;
+
+        const auto scale = _mm_set1_ps( traits::template write_scale<float>() );
+        const auto max   = _mm_set1_ps( traits::template write_max<float>() );
+
+        size_t i = 0;
+        for ( ; i + 16 <= n; i += 16, src += 16, dst += 16 )
+        {
+            const auto lo = _mm_packs_epi32( quantize( src, scale, max ), quantize( src + 4, scale, max ) );
+            const auto hi = _mm_packs_epi32( quantize( src + 8, scale, max ), quantize( src + 12, scale, max ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ),
+                              _mm_packus_epi16( encode( lo, number{} ), encode( hi, number{} ) ) );
+        }
+
+        scalar::write<Value, Format>( src, n - i, dst );
+    }
+
+    template <class Value, class Format>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void write( const Value* src, size_t n, char* dst )
+    {
+        write<Value, Format>( src, n, dst, is_companded_format<Format>{} );
+    }
+
+    template <class Source, class Target>
+    NIMEDIA_PCM_TARGET_SSE2
+    static void byteswap( const char* src, size_t n, char* dst )
+    {
+        using traits = kernel_traits<Source>;
+
+        constexpr size_t block = 16 / traits::bytes;
+
+        size_t i = 0;
+        for ( ; i + block <= n; i += block, src += 16, dst += 16 )
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), sse2::byteswap( load( src ), bits_t<traits::bits>{} ) );
+
+        scalar::byteswap<Source, Target>( src, n - i, dst );
+    }
+};
+
+// deinterleaves 4 frames at a time, stereo with a shuffle, everything from 4 channels up
+// with 4x4 transposes. The last group of 4 channels overlaps the previous one if needed.
+NIMEDIA_PCM_TARGET_SSE2
+inline void deinterleave( const float* src, size_t frames, size_t channels, float* const* dst, size_t offset )
+{
+    size_t f = 0;
+
+    if ( channels == 2 )
+    {
+        const auto left  = dst[0] + offset;
+        const auto right = dst[1] + offset;
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto a = _mm_loadu_ps( src + 2 * f );
+            const auto b = _mm_loadu_ps( src + 2 * f + 4 );
+            _mm_storeu_ps( left + f, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+            _mm_storeu_ps( right + f, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+        }
+    }
+    else if ( channels >= 4 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto frame = src + f * channels;
+            for ( size_t c = 0; c < channels; c += 4 )
+            {
+                const auto first = std::min( c, channels - 4 );
+
+                auto r0 = _mm_loadu_ps( frame + first );
+                auto r1 = _mm_loadu_ps( frame + channels + first );
+                auto r2 = _mm_loadu_ps( frame + 2 * channels + first );
+                auto r3 = _mm_loadu_ps( frame + 3 * channels + first );
+                _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+                _mm_storeu_ps( dst[first] + offset + f, r0 );
+                _mm_storeu_ps( dst[first + 1] + offset + f, r1 );
+                _mm_storeu_ps( dst[first + 2] + offset + f, r2 );
+                _mm_storeu_ps( dst[first + 3] + offset + f, r3 );
+            }
+        }
+    }
+
+    scalar::deinterleave( src + f * channels, frames - f, channels, dst, offset + f );
+}
+
+// the inverse of deinterleave
+NIMEDIA_PCM_TARGET_SSE2
+inline void interleave( const float* const* src, size_t offset, size_t frames, size_t channels, float* dst )
+{
+    size_t f = 0;
+
+    if ( channels == 2 )
+    {
+        const auto left  = src[0] + offset;
+        const auto right = src[1] + offset;
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto l = _mm_loadu_ps( left + f );
+            const auto r = _mm_loadu_ps( right + f );
+            _mm_storeu_ps( dst + 2 * f, _mm_unpacklo_ps( l, r ) );
+            _mm_storeu_ps( dst + 2 * f + 4, _mm_unpackhi_ps( l, r ) );
+        }
+    }
+    else if ( channels >= 4 )
+    {
+        for ( ; f + 4 <= frames; f += 4 )
+        {
+            const auto frame = dst + f * channels;
+            for ( size_t c = 0; c < channels; c += 4 )
+            {
+                const auto first = std::min( c, channels - 4 );
+
+                auto r0 = _mm_loadu_ps( src[first] + offset + f );
+                auto r1 = _mm_loadu_ps( src[first + 1] + offset + f );
+                auto r2 = _mm_loadu_ps( src[first + 2] + offset + f );
+                auto r3 = _mm_loadu_ps( src[first + 3] + offset + f );
+                _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+                _mm_storeu_ps( frame + first, r0 );
+                _mm_storeu_ps( frame + channels + first, r1 );
+                _mm_storeu_ps( frame + 2 * channels + first, r2 );
+                _mm_storeu_ps( frame + 3 * channels + first, r3 );
+            }
+        }
+    }
+
+    scalar::interleave( src, offset + f, frames - f, channels, dst + f * channels );
+}
+
+// mono to stereo, 4 frames at a time
+NIMEDIA_PCM_TARGET_SSE2
+inline void mix_1_2( const float* src, size_t frames, size_t, size_t, const float* matrix, float* dst )
+{
+    const auto left  = _mm_set1_ps( matrix[0] );
+    const auto right = _mm_set1_ps( matrix[1] );
+
+    size_t f = 0;
+    for ( ; f + 4 <= frames; f += 4 )
+    {
+        const auto mono = _mm_loadu_ps( src + f );
+        const auto l    = _mm_mul_ps( mono, left );
+        const auto r    = _mm_mul_ps( mono, right );
+        _mm_storeu_ps( dst + 2 * f, _mm_unpacklo_ps( l, r ) );
+        _mm_storeu_ps( dst + 2 * f + 4, _mm_unpackhi_ps( l, r ) );
+    }
+
+    scalar::mix_fixed<float, 1, 2>( src + f, frames - f, 1, 2, matrix, dst + 2 * f );
+}
+
+// stereo to mono, 4 frames at a time
+NIMEDIA_PCM_TARGET_SSE2
+inline void mix_2_1( const float* src, size_t frames, size_t, size_t, const float* matrix, float* dst )
+{
+    const auto left  = _mm_set1_ps( matrix[0] );
+    const auto right = _mm_set1_ps( matrix[1] );
+
+    size_t f = 0;
+    for ( ; f + 4 <= frames; f += 4 )
+    {
+        const auto a = _mm_loadu_ps( src + 2 * f );
+        const auto b = _mm_loadu_ps( src + 2 * f + 4 );
+        const auto l = _mm_mul_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ), left );
+        const auto r = _mm_mul_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ), right );
+        _mm_storeu_ps( dst + f, _mm_add_ps( l, r ) );
+    }
+
+    scalar::mix_fixed<float, 2, 1>( src + 2 * f, frames - f, 2, 1, matrix, dst + f );
+}
+
+// 5.1 to stereo, 2 frames at a time as [l0 r0 l1 r1], each channel broadcast to the lanes of its frame
+NIMEDIA_PCM_TARGET_SSE2
+inline void mix_6_2( const float* src, size_t frames, size_t, size_t, const float* matrix, float* dst )
+{
+    __m128 gains[6];
+    for ( size_t i = 0; i < 6; ++i )
+        gains[i] = _mm_setr_ps( matrix[i], matrix[6 + i], matrix[i], matrix[6 + i] );
+
+    size_t f = 0;
+    for ( ; f + 2 <= frames; f += 2 )
+    {
+        const auto a = _mm_loadu_ps( src + 6 * f );
+        const auto b = _mm_loadu_ps( src + 6 * f + 4 );
+        const auto c = _mm_loadu_ps( src + 6 * f + 8 );
+
+        auto sum = _mm_mul_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 2, 0, 0 ) ), gains[0] );
+        sum      = _mm_add_ps( sum, _mm_mul_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 3, 1, 1 ) ), gains[1] ) );
+        sum      = _mm_add_ps( sum, _mm_mul_ps( _mm_shuffle_ps( a, c, _MM_SHUFFLE( 0, 0, 2, 2 ) ), gains[2] ) );
+        sum      = _mm_add_ps( sum, _mm_mul_ps( _mm_shuffle_ps( a, c, _MM_SHUFFLE( 1, 1, 3, 3 ) ), gains[3] ) );
+        sum      = _mm_add_ps( sum, _mm_mul_ps( _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 2, 0, 0 ) ), gains[4] ) );
+        sum      = _mm_add_ps( sum, _mm_mul_ps( _mm_shuffle_ps( b, c, _MM_SHUFFLE( 3, 3, 1, 1 ) ), gains[5] ) );
+        _mm_storeu_ps( dst + 2 * f, sum );
+    }
+
+    scalar::mix_fixed<float, 6, 2>( src + 6 * f, frames - f, 6, 2, matrix, dst + 2 * f );
+}
+
+// block reductions, 4 floats at a time
+
+NIMEDIA_PCM_TARGET_SSE2 inline float horizontal_min( __m128 x )
+{
+    x = _mm_min_ps( x, _mm_movehl_ps( x, x ) );
+    return _mm_cvtss_f32( _mm_min_ss( x, _mm_shuffle_ps( x, x, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline float horizontal_max( __m128 x )
+{
+    x = _mm_max_ps( x, _mm_movehl_ps( x, x ) );
+    return _mm_cvtss_f32( _mm_max_ss( x, _mm_shuffle_ps( x, x, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline double horizontal_sum( __m128d x )
+{
+    return _mm_cvtsd_f64( _mm_add_sd( x, _mm_unpackhi_pd( x, x ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 abs( __m128 x )
+{
+    return _mm_andnot_ps( _mm_set1_ps( -0.f ), x );
+}
+
+NIMEDIA_PCM_TARGET_SSE2
+inline auto min_max( const float* src, size_t n, std::pair<float, float> result ) -> std::pair<float, float>
+{
+    if ( n < 4 )
+        return scalar::min_max( src, n, result );
+
+    auto lo = _mm_set1_ps( result.first );
+    auto hi = _mm_set1_ps( result.second );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto x = _mm_loadu_ps( src + i );
+        lo           = _mm_min_ps( lo, x );
+        hi           = _mm_max_ps( hi, x );
+    }
+
+    return scalar::min_max( src + i, n - i, std::make_pair( horizontal_min( lo ), horizontal_max( hi ) ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline auto peak( const float* src, size_t n, float result ) -> float
+{
+    auto hi = _mm_set1_ps( result );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        hi = _mm_max_ps( hi, abs( _mm_loadu_ps( src + i ) ) );
+
+    return scalar::peak( src + i, n - i, horizontal_max( hi ) );
+}
+
+// summed in double like the scalar kernels, two lanes per half
+NIMEDIA_PCM_TARGET_SSE2 inline auto sum( const float* src, size_t n, double result ) -> double
+{
+    auto lo = _mm_setzero_pd();
+    auto hi = _mm_setzero_pd();
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto x = _mm_loadu_ps( src + i );
+        lo           = _mm_add_pd( lo, _mm_cvtps_pd( x ) );
+        hi           = _mm_add_pd( hi, _mm_cvtps_pd( _mm_movehl_ps( x, x ) ) );
+    }
+
+    return scalar::sum( src + i, n - i, result ) + horizontal_sum( _mm_add_pd( lo, hi ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline auto sum_of_squares( const float* src, size_t n, double result ) -> double
+{
+    auto lo = _mm_setzero_pd();
+    auto hi = _mm_setzero_pd();
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto x = _mm_loadu_ps( src + i );
+        const auto l = _mm_cvtps_pd( x );
+        const auto h = _mm_cvtps_pd( _mm_movehl_ps( x, x ) );
+        lo           = _mm_add_pd( lo, _mm_mul_pd( l, l ) );
+        hi           = _mm_add_pd( hi, _mm_mul_pd( h, h ) );
+    }
+
+    return scalar::sum_of_squares( src + i, n - i, result ) + horizontal_sum( _mm_add_pd( lo, hi ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline auto find_above( const float* src, size_t n, float threshold ) -> size_t
+{
+    const auto limit = _mm_set1_ps( threshold );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        if ( _mm_movemask_ps( _mm_cmpgt_ps( abs( _mm_loadu_ps( src + i ) ), limit ) ) != 0 )
+            break;
+
+    return i + scalar::find_above( src + i, n - i, threshold );
+}
+
+// triangular dither, one xorshift32 generator per lane
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128i xorshift( __m128i& x )
+{
+    x = _mm_xor_si128( x, _mm_slli_epi32( x, 13 ) );
+    x = _mm_xor_si128( x, _mm_srli_epi32( x, 17 ) );
+    x = _mm_xor_si128( x, _mm_slli_epi32( x, 5 ) );
+    return x;
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 uniform( __m128i x )
+{
+    const auto one = _mm_castsi128_ps( _mm_or_si128( _mm_srli_epi32( x, 9 ), _mm_set1_epi32( 0x3f800000 ) ) );
+    return _mm_sub_ps( one, _mm_set1_ps( 1.f ) );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 triangular( __m128i& state, __m128 lsb )
+{
+    const auto a = uniform( xorshift( state ) );
+    const auto b = uniform( xorshift( state ) );
+    return _mm_mul_ps( _mm_sub_ps( a, b ), lsb );
+}
+
+// clamp, round half away from zero to a multiple of lsb
+NIMEDIA_PCM_TARGET_SSE2 inline __m128 quantize( __m128 x, __m128 lsb, __m128 scale )
+{
+    const auto clamped = _mm_min_ps( _mm_max_ps( x, _mm_set1_ps( -1.f ) ), _mm_sub_ps( _mm_set1_ps( 1.f ), lsb ) );
+    const auto scaled  = _mm_mul_ps( clamped, scale );
+    const auto half    = _mm_or_ps( _mm_and_ps( scaled, _mm_set1_ps( -0.f ) ), _mm_set1_ps( 0.5f ) );
+    return _mm_mul_ps( _mm_cvtepi32_ps( _mm_cvttps_epi32( _mm_add_ps( scaled, half ) ) ), lsb );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void noise( size_t n, float lsb, uint32_t* state, float* dst )
+{
+    auto       lanes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( state ) );
+    const auto step  = _mm_set1_ps( lsb );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+        _mm_storeu_ps( dst + i, triangular( lanes, step ) );
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state ), lanes );
+    scalar::noise( n - i, lsb, state, dst + i );
+}
+
+NIMEDIA_PCM_TARGET_SSE2 inline void tpdf( const float* src, size_t n, float lsb, uint32_t* state, float* dst )
+{
+    auto       lanes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( state ) );
+    const auto step  = _mm_set1_ps( lsb );
+    const auto scale = _mm_set1_ps( 1.f / lsb );
+
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const auto x = _mm_add_ps( _mm_loadu_ps( src + i ), triangular( lanes, step ) );
+        _mm_storeu_ps( dst + i, quantize( x, step, scale ) );
+    }
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state ), lanes );
+    scalar::tpdf( src + i, n - i, lsb, state, dst + i );
+}
+
+} // namespace sse2
+} // namespace detail
+} // namespace pcm
+
+#endif
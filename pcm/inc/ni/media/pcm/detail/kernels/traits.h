@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/converter.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+template <int bits>
+using bits_t = std::integral_constant<int, bits>;
+
+// compiletime properties of a format, as needed by the vectorized kernels
+template <class Format>
+struct kernel_traits
+{
+    using storage_type = typename storage<Format>::type;
+
+    static constexpr int    bits         = Format{}.bitwidth();
+    static constexpr size_t bytes        = bits / 8;
+    static constexpr bool   is_integer   = Format{}.number() == signed_integer || Format{}.number() == unsigned_integer;
+    static constexpr bool   is_unsigned  = Format{}.number() == unsigned_integer;
+    static constexpr bool   is_companded = detail::is_companded<Format{}.number()>::value;
+    static constexpr bool   is_half      = detail::is_half<Format>::value;
+    static constexpr bool   is_native    = bits == 8 || Format{}.endian() == native_endian;
+    static constexpr int    valid_bits   = Format{}.valid_bits();
+    static constexpr bool   is_padded    = valid_bits < bits;
+
+    // sign_cast applied to a sample aligned to the upper bits of a 32 bit lane
+    static constexpr int32_t read_flip = is_unsigned ? ~int32_t( 0x7fffffff ) : 0;
+
+    // sign_cast applied to the packed samples
+    static constexpr int32_t write_flip = !is_unsigned ? 0
+                                          : bits == 8  ? ~int32_t( 0x7f7f7f7f )
+                                          : bits == 16 ? ~int32_t( 0x7fff7fff )
+                                                       : ~int32_t( 0x7fffffff );
+
+    // clears the padding bits of a sample aligned to the upper bits of a 32 bit lane, all ones without padding
+    static constexpr int32_t read_mask = is_padded ? int32_t( ~uint32_t( 0 ) << ( 32 - valid_bits ) ) : ~int32_t( 0 );
+
+    // clears the padding bits of the packed samples
+    static constexpr int32_t write_mask = bits == 16 ? int32_t( ( uint32_t( read_mask ) >> 16 ) * 0x00010001u ) //
+                                                     : read_mask;
+
+    // samples read by the vectorized kernels are aligned to the upper bits of an int32_t
+    template <class Real>
+    static constexpr Real read_scale()
+    {
+        return Real{1} / ( 1ull << 31 );
+    }
+
+    // same scale and clipping as convert_to<storage_type>
+    template <class Real>
+    static constexpr Real write_scale()
+    {
+        return Real( 1ull << ( sizeof( storage_type ) * 8 - 1 ) );
+    }
+
+    template <class Real>
+    static constexpr Real write_max()
+    {
+        return Real{1} - std::max( 1 / write_scale<Real>(), std::numeric_limits<Real>::epsilon() );
+    }
+};
+
+// integer formats up to 32 bit in native byte order are handled by the vectorized kernels
+template <class Format>
+using is_simd_integer_format = std::integral_constant<bool,
+                                                      kernel_traits<Format>::is_integer
+                                                          && kernel_traits<Format>::is_native
+                                                          && kernel_traits<Format>::bits <= 32>;
+
+// formats in the opposite byte order that are read by the vectorized kernels with a byte shuffle:
+// integer formats up to 32 bit and floating point formats (e.g. big endian AIFF data on x86 and arm).
+// Half floats have kernels of their own.
+template <class Format>
+using is_simd_swapped_format = std::integral_constant<bool,
+                                                      !kernel_traits<Format>::is_native
+                                                          && !kernel_traits<Format>::is_half
+                                                          && ( !kernel_traits<Format>::is_integer
+                                                               || kernel_traits<Format>::bits <= 32 )>;
+
+template <class Format>
+using is_native_format = std::integral_constant<bool, kernel_traits<Format>::is_native>;
+
+template <class Format>
+using is_integer_format = std::integral_constant<bool, kernel_traits<Format>::is_integer>;
+
+template <class Format>
+using is_companded_format = std::integral_constant<bool, kernel_traits<Format>::is_companded>;
+
+template <class Format>
+using is_half_format = std::integral_constant<bool, kernel_traits<Format>::is_half>;
+
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/kernels/packed24.h>
+#include <ni/media/pcm/detail/kernels/sample.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+// converts n samples from one pcm format to another
+using transcode_kernel_t = void ( * )( const char*, size_t, char* );
+
+enum class transcode_path
+{
+    identical,
+    byteswap,
+    to_native_real,
+    from_native_real,
+    generic,
+};
+
+template <transcode_path p>
+using transcode_path_t = std::integral_constant<transcode_path, p>;
+
+template <class Source, class Target>
+constexpr auto select_transcode_path()
+{
+    // same number type and width, only the byte order differs
+    constexpr bool byteswap = Source{}.number() == Target{}.number() && Source{}.bitwidth() == Target{}.bitwidth()
+                              && Source{}.valid_bits() == Target{}.valid_bits();
+
+    // one side is float / double in native byte order, so the read and write kernels apply
+    constexpr bool to_native_real   = Target{}.number() == floating_point && Target{}.bitwidth() >= _32bit
+                                    && Target{}.endian() == native_endian;
+    constexpr bool from_native_real = Source{}.number() == floating_point && Source{}.bitwidth() >= _32bit
+                                    && Source{}.endian() == native_endian;
+
+    // 8 bit samples have no byte order
+    constexpr bool identical = std::is_same<Source, Target>::value || ( byteswap && Source{}.bitwidth() == 8 );
+
+    return identical          ? transcode_path::identical
+           : byteswap         ? transcode_path::byteswap
+           : to_native_real   ? transcode_path::to_native_real
+           : from_native_real ? transcode_path::from_native_real
+                              : transcode_path::generic;
+}
+
+template <class T>
+bool is_aligned( const void* ptr )
+{
+    return reinterpret_cast<uintptr_t>( ptr ) % alignof( T ) == 0;
+}
+
+namespace scalar
+{
+
+// integer to integer uses sign_cast / shift_cast and stays exact, floating point is only involved
+// if one of the formats is floating point
+template <class Source, class Target>
+void transcode( const char* src, size_t n, char* dst )
+{
+    using target_storage = typename storage<Target>::type;
+
+    constexpr auto src_step = Source{}.bitwidth() / 8;
+    constexpr auto dst_step = Target{}.bitwidth() / 8;
+
+    for ( size_t i = 0; i < n; ++i, src += src_step, dst += dst_step )
+        store_sample<Target>( dst, convert_to<target_storage>( load_sample<Source>( src ) ) );
+}
+
+template <class Source, class Target>
+void byteswap_n( const char* src, size_t n, char* dst, std::true_type /*packed24*/ )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4, src += 12, dst += 12 )
+    {
+        uint32_t samples[4];
+        packed24::load4<Source{}.endian()>( src, samples );
+        packed24::store4<Target{}.endian()>( dst, samples );
+    }
+
+    transcode<Source, Target>( src, n - i, dst );
+}
+
+// swaps the stored words, so half float NaNs keep their bits like in the vectorized byteswap kernels
+template <class Source, class Target>
+void byteswap_n( const char* src, size_t n, char* dst, std::false_type /*packed24*/ )
+{
+    using word_type = word_t<Source{}.bitwidth() / 8>;
+
+    for ( size_t i = 0; i < n; ++i, src += sizeof( word_type ), dst += sizeof( word_type ) )
+    {
+        word_type word;
+        std::memcpy( &word, src, sizeof( word ) );
+        word = detail::byteswap( word );
+        std::memcpy( dst, &word, sizeof( word ) );
+    }
+}
+
+template <class Source, class Target>
+void byteswap( const char* src, size_t n, char* dst )
+{
+    byteswap_n<Source, Target>( src, n, dst, std::integral_constant<bool, Source{}.bitwidth() == 24>{} );
+}
+
+} // namespace scalar
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/contiguous.h>
+#include <ni/media/pcm/detail/kernels.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace pcm
+{
+namespace detail
+{
+
+// raw pcm bytes in contiguous memory, analysed as floating point values
+template <class Value, class Iterator>
+using enable_if_contiguous_reduce_t =
+    std::enable_if_t<is_contiguous_byte_iterator<Iterator>::value && std::is_floating_point<Value>::value>;
+
+// converts the samples block by block into an L1 sized buffer and calls f( block, size, offset ) on each,
+// so the whole range is never materialized as Value. f returns false to stop early.
+template <class Value, class Iterator, number_type n, bitwidth_type b, endian_type e, bitwidth_type v, class F>
+void for_each_block( contiguous_iterator<Value, Iterator, n, b, e, v> beg,
+                     contiguous_iterator<Value, Iterator, n, b, e, v> end,
+                     F                                                f )
+{
+    using Format = compiletime_format<n, b, e, v>;
+
+    const auto count = size_t( std::distance( beg, end ) );
+    if ( count == 0 )
+        return;
+
+    const auto read  = read_kernel<Value, Format>();
+    const auto src   = reinterpret_cast<const char*>( to_address( beg.base() ) );
+    const auto bytes = size_t( Format{}.bitwidth() / 8 );
+
+    std::array<Value, planar_block_size> block;
+    for ( size_t offset = 0; offset < count; offset += block.size() )
+    {
+        const auto size = std::min( block.size(), count - offset );
+        read( src + offset * bytes, size, block.data() );
+        if ( !f( block.data(), size, offset ) )
+            break;
+    }
+}
+
+} // namespace detail
+} // namespace pcm
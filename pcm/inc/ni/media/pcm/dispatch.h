@@ -30,8 +30,31 @@
 #include <type_traits>
 #include <utility>
 
+#ifndef NIMEDIA_PCM_COMMON_DISPATCH_FORMATS
+#define NIMEDIA_PCM_COMMON_DISPATCH_FORMATS 0
+#endif
+
 namespace pcm
 {
+
+// The formats dispatch generates specialized code for. Every dispatched call instantiates its function
+// for each combination of these formats, so restricting them to the common ones saves a lot of code.
+// Runtime formats outside of this set take the generic runtime_format path, which is slower but complete.
+#if NIMEDIA_PCM_COMMON_DISPATCH_FORMATS
+inline constexpr auto dispatch_formats()
+{
+    return std::tuple<compiletime_format<signed_integer, _16bit, little_endian>,
+                      compiletime_format<signed_integer, _24bit, little_endian>,
+                      compiletime_format<signed_integer, _32bit, little_endian>,
+                      compiletime_format<floating_point, _32bit, little_endian>>();
+}
+#else
+inline constexpr auto dispatch_formats()
+{
+    return compiletime_formats();
+}
+#endif
+
 namespace detail
 {
 
@@ -68,6 +91,12 @@ Result invoke( catch_t, F, Ts... )
 }
 
 
+// formats missing from the set are not specialized, their iterators are passed on with the runtime format
+template <class Formats>
+using is_complete_format_set = std::integral_constant<bool,
+                                                      std::tuple_size<Formats>::value
+                                                          == std::tuple_size<decltype( compiletime_formats() )>::value>;
+
 template <class...>
 struct dispatch_impl
 {
@@ -101,7 +130,8 @@ struct dispatch_impl<R, F, std::tuple<::pcm::iterator<Value, Iter>, As...>, std:
 {
     auto operator()( F f, ::pcm::iterator<Value, Iter> it, As... as, Bs... bs )
     {
-        R r;
+        R    r;
+        bool found = false;
         []( ... ) {}( it.format() == Formats{}
                       && ( r = ( dispatch_impl<R,
                                                F,
@@ -109,9 +139,29 @@ struct dispatch_impl<R, F, std::tuple<::pcm::iterator<Value, Iter>, As...>, std:
                                                std::tuple<Bs..., ::pcm::iterator<Value, Iter, Formats>>,
                                                std::tuple<Formats...>>()(
                                f, as..., bs..., ::pcm::iterator<Value, Iter, Formats>( it.base(), Formats{} ) ) ),
+                           found = true,
                            false )... );
+        if ( !found )
+            r = fallback( is_complete_format_set<std::tuple<Formats...>>{}, f, it, as..., bs... );
         return r;
     }
+
+private:
+    static R fallback( std::true_type, F, ::pcm::iterator<Value, Iter>, As..., Bs... )
+    {
+        assert( !"every runtime format is part of the dispatched formats" );
+        return R();
+    }
+
+    static R fallback( std::false_type, F f, ::pcm::iterator<Value, Iter> it, As... as, Bs... bs )
+    {
+        auto impl = dispatch_impl<R,
+                                  F,
+                                  std::tuple<As...>,
+                                  std::tuple<Bs..., ::pcm::iterator<Value, Iter>>,
+                                  std::tuple<Formats...>>();
+        return impl( f, as..., bs..., it );
+    }
 };
 
 // Recursive case, with dispatch, without return type
@@ -120,6 +170,7 @@ struct dispatch_impl<void, F, std::tuple<::pcm::iterator<Value, Iter>, As...>, s
 {
     auto operator()( F f, ::pcm::iterator<Value, Iter> it, As... as, Bs... bs )
     {
+        bool found = false;
         []( ... ) {}( it.format() == Formats{}
                       && ( dispatch_impl<void,
                                          F,
@@ -127,19 +178,44 @@ struct dispatch_impl<void, F, std::tuple<::pcm::iterator<Value, Iter>, As...>, s
                                          std::tuple<Bs..., ::pcm::iterator<Value, Iter, Formats>>,
                                          std::tuple<Formats...>>()(
                                f, as..., bs..., ::pcm::iterator<Value, Iter, Formats>( it.base(), Formats{} ) ),
+                           found = true,
                            false )... );
+        if ( !found )
+            fallback( is_complete_format_set<std::tuple<Formats...>>{}, f, it, as..., bs... );
+    }
+
+private:
+    static void fallback( std::true_type, F, ::pcm::iterator<Value, Iter>, As..., Bs... )
+    {
+        assert( !"every runtime format is part of the dispatched formats" );
+    }
+
+    static void fallback( std::false_type, F f, ::pcm::iterator<Value, Iter> it, As... as, Bs... bs )
+    {
+        auto impl = dispatch_impl<void,
+                                  F,
+                                  std::tuple<As...>,
+                                  std::tuple<Bs..., ::pcm::iterator<Value, Iter>>,
+                                  std::tuple<Formats...>>();
+        impl( f, as..., bs..., it );
     }
 };
 
 } // namespace detail
 
+// calls f with every pcm iterator in ts converted to the compiletime format out of Formats matching its runtime format
+template <class Formats, class F, class... Ts>
+auto dispatch_to( F f, Ts... ts )
+{
+    using Result = decltype( f( ts... ) );
+    auto impl    = detail::dispatch_impl<Result, F, std::tuple<Ts...>, std::tuple<>, Formats>();
+    return impl( f, ts... );
+}
+
 template <class F, class... Ts>
 auto dispatch( F f, Ts... ts )
 {
-    using Result  = decltype( f( ts... ) );
-    using Formats = decltype( compiletime_formats() );
-    auto impl     = detail::dispatch_impl<Result, F, std::tuple<Ts...>, std::tuple<>, Formats>();
-    return impl( f, ts... );
+    return dispatch_to<decltype( dispatch_formats() )>( f, ts... );
 }
 
 } // namespace pcm
@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/detail/kernels.h>
+#include <ni/media/pcm/runtime_format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace pcm
+{
+
+enum class dither_type
+{
+    none,
+    tpdf,                // triangular noise of +-1 lsb
+    first_order_shaped,  // tpdf with the quantization error fed back, pushing the noise towards nyquist
+    second_order_shaped, // as first_order_shaped with a steeper (1 - z^-1)^2 noise transfer
+};
+
+namespace detail
+{
+
+// the quantization step of fmt as a value in [-1, 1), zero for formats which are not dithered.
+// wider integer formats are finer than the mantissa of a float, companded formats have no uniform step.
+template <class Value>
+auto dither_lsb( const runtime_format& fmt ) -> Value
+{
+    const auto is_integer = fmt.number() == signed_integer || fmt.number() == unsigned_integer;
+    if ( !is_integer || fmt.bitwidth() > 24 )
+        return Value{0};
+
+    return Value{1} / Value( 1u << ( fmt.bitwidth() - 1 ) );
+}
+
+} // namespace detail
+
+// Dither state of one stream of interleaved frames: the generator state and the last quantization
+// errors of each channel, so consecutive blocks continue where the previous one stopped.
+// Dithered values are multiples of the format's lsb within [-1, 1 - lsb], which the write kernels
+// store without further rounding. Floating point, companded and integer formats wider than 24 bit pass
+// unchanged.
+class dither
+{
+public:
+    explicit dither( dither_type type = dither_type::none, size_t channels = 1, uint32_t seed = 1 )
+    : m_type( type )
+    , m_channels( std::max( channels, size_t( 1 ) ) )
+    , m_seed( seed )
+    , m_errors( 2 * m_channels )
+    {
+        reset();
+    }
+
+    auto type() const -> dither_type
+    {
+        return m_type;
+    }
+
+    auto channels() const -> size_t
+    {
+        return m_channels;
+    }
+
+    // restarts the noise sequence and clears the error history, i.e. after seeking
+    void reset()
+    {
+        // splitmix32 spreads consecutive seeds, xorshift needs non zero lanes
+        for ( size_t lane = 0; lane < m_state.size(); ++lane )
+        {
+            auto x = m_seed + uint32_t( lane + 1 ) * 0x9e3779b9u;
+            x      = ( x ^ ( x >> 16 ) ) * 0x85ebca6bu;
+            x      = ( x ^ ( x >> 13 ) ) * 0xc2b2ae35u;
+            x ^= x >> 16;
+            m_state[lane] = x != 0 ? x : 1;
+        }
+        std::fill( m_errors.begin(), m_errors.end(), 0. );
+        m_channel = 0;
+        m_lane    = 0;
+    }
+
+    // dithers n interleaved values for the target format fmt, src and dst may be the same
+    template <class Value>
+    void apply( const Value* src, size_t n, const runtime_format& fmt, Value* dst )
+    {
+        static_assert( std::is_floating_point<Value>::value, "only floating point values are dithered" );
+
+        const auto lsb = detail::dither_lsb<Value>( fmt );
+        if ( m_type == dither_type::none || lsb == 0 )
+        {
+            std::copy( src, src + n, dst );
+            return;
+        }
+
+        // the kernels start at lane 0, rotating the lanes keeps the noise independent of how the stream is split
+        std::rotate( m_state.begin(), m_state.begin() + m_lane, m_state.end() );
+
+        if ( m_type == dither_type::tpdf )
+        {
+            detail::dither_kernels<Value>().tpdf( src, n, lsb, m_state.data(), dst );
+            m_channel = ( m_channel + n ) % m_channels;
+        }
+        else
+        {
+            shape( src, n, lsb, dst );
+        }
+
+        std::rotate( m_state.begin(), m_state.end() - m_lane, m_state.end() );
+        m_lane = ( m_lane + n ) % m_state.size();
+    }
+
+private:
+    // error feedback per channel: v = x - h * e, y = quantize( v + noise ), e = y - v.
+    // the error is limited so clipping input cannot make the loop unstable.
+    template <class Value>
+    void shape( const Value* src, size_t n, Value lsb, Value* dst )
+    {
+        const auto noise     = detail::dither_kernels<Value>().noise;
+        const auto max_error = 2 * lsb;
+
+        // h = z^-1 or 2 z^-1 - z^-2
+        const auto h1 = Value( m_type == dither_type::first_order_shaped ? 1 : 2 );
+        const auto h2 = Value( m_type == dither_type::first_order_shaped ? 0 : -1 );
+
+        auto errors = std::vector<Value>( m_errors.begin(), m_errors.end() );
+
+        std::array<Value, detail::planar_block_size> block;
+        for ( size_t offset = 0; offset < n; offset += block.size() )
+        {
+            const auto count = std::min( block.size(), n - offset );
+            noise( count, lsb, m_state.data(), block.data() );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                auto* e = errors.data() + 2 * m_channel;
+
+                const auto v = src[offset + i] - ( h1 * e[0] + h2 * e[1] );
+                const auto y = detail::scalar::quantize( v + block[i], lsb );
+
+                e[1]            = e[0];
+                e[0]            = std::min( std::max( y - v, -max_error ), max_error );
+                dst[offset + i] = y;
+
+                if ( ++m_channel == m_channels )
+                    m_channel = 0;
+            }
+        }
+
+        std::copy( errors.begin(), errors.end(), m_errors.begin() );
+    }
+
+    dither_type                                m_type;
+    size_t                                     m_channels;
+    uint32_t                                   m_seed;
+    std::array<uint32_t, detail::dither_lanes> m_state;
+    std::vector<double>                        m_errors;
+    size_t                                     m_channel = 0;
+    size_t                                     m_lane    = 0;
+};
+
+} // namespace pcm
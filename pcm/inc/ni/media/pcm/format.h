@@ -32,10 +32,10 @@ namespace pcm
 using format = runtime_format;
 
 
-template <number_type n, bitwidth_type b, endian_type e = native_endian>
+template <number_type n, bitwidth_type b, endian_type e = native_endian, bitwidth_type v = b>
 constexpr auto make_format()
 {
-    return compiletime_format<n, b, e>{};
+    return compiletime_format<n, b, e, v>{};
 }
 
 inline auto make_format( number_type n, bitwidth_type b, endian_type e )
@@ -43,6 +43,11 @@ inline auto make_format( number_type n, bitwidth_type b, endian_type e )
     return runtime_format{n, b, e};
 }
 
+inline auto make_format( number_type n, bitwidth_type b, endian_type e, bitwidth_type v )
+{
+    return runtime_format{n, b, e, v};
+}
+
 
 // the following functions are for backwards compatibility and are not needed anymore
 template <class Format>
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace pcm
+{
+
+// How the parallel pcm algorithms split their work: chunks of about chunk_bytes of pcm data, a whole
+// number of frames of `channels` samples each, are handed out to up to num_threads threads, the calling
+// thread included. A num_threads of 0 uses every hardware thread. Inputs of less than two chunks are
+// converted on the calling thread.
+class parallel_policy
+{
+public:
+    static constexpr size_t default_chunk_bytes = size_t( 1 ) << 18;
+
+    explicit parallel_policy( size_t num_threads = 0, size_t channels = 1, size_t chunk_bytes = default_chunk_bytes )
+    : m_num_threads( num_threads != 0 ? num_threads : std::max<size_t>( std::thread::hardware_concurrency(), 1 ) )
+    , m_channels( std::max( channels, size_t( 1 ) ) )
+    , m_chunk_bytes( std::max( chunk_bytes, size_t( 1 ) ) )
+    {
+    }
+
+    auto num_threads() const -> size_t
+    {
+        return m_num_threads;
+    }
+
+    auto channels() const -> size_t
+    {
+        return m_channels;
+    }
+
+    auto chunk_bytes() const -> size_t
+    {
+        return m_chunk_bytes;
+    }
+
+    // samples per chunk for samples of bytes_per_sample bytes, a multiple of the frame size and of the
+    // 64 samples all kernels convert per block, so only the last chunk ends in a scalar tail
+    auto chunk_size( size_t bytes_per_sample ) const -> size_t
+    {
+        const auto frame  = m_channels * 64 / gcd( m_channels, 64 );
+        const auto frames = std::max<size_t>( m_chunk_bytes / ( std::max<size_t>( bytes_per_sample, 1 ) * frame ), 1 );
+        return frames * frame;
+    }
+
+private:
+    static auto gcd( size_t a, size_t b ) -> size_t
+    {
+        return b == 0 ? a : gcd( b, a % b );
+    }
+
+    size_t m_num_threads;
+    size_t m_channels;
+    size_t m_chunk_bytes;
+};
+
+namespace detail
+{
+
+// calls f( offset, size ) for consecutive chunks covering [0, count), chunks are taken from a shared
+// counter so faster threads pick up more of them. The first exception thrown by f is rethrown.
+template <class F>
+void parallel_for_chunks( const parallel_policy& policy, size_t count, size_t chunk_size, F f )
+{
+    const auto num_chunks  = ( count + chunk_size - 1 ) / chunk_size;
+    const auto num_threads = std::min( policy.num_threads(), num_chunks );
+
+    if ( num_threads < 2 )
+    {
+        if ( count > 0 )
+            f( size_t( 0 ), count );
+        return;
+    }
+
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<bool>   failed{false};
+    std::exception_ptr  error;
+
+    auto work = [&]() {
+        try
+        {
+            for ( auto chunk = next_chunk++; chunk < num_chunks && !failed; chunk = next_chunk++ )
+            {
+                const auto offset = chunk * chunk_size;
+                f( offset, std::min( chunk_size, count - offset ) );
+            }
+        }
+        catch ( ... )
+        {
+            if ( !failed.exchange( true ) )
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( num_threads - 1 );
+    try
+    {
+        for ( size_t i = 1; i < num_threads; ++i )
+            threads.emplace_back( work );
+    }
+    catch ( const std::system_error& )
+    {
+        // out of threads, the ones started and the calling thread share the chunks
+    }
+
+    work();
+
+    for ( auto& thread : threads )
+        thread.join();
+
+    if ( error )
+        std::rethrow_exception( error );
+}
+
+} // namespace detail
+} // namespace pcm
@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#pragma once
+
+#include <ni/media/pcm/iterator.h>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace pcm
+{
+
+// a piece of raw pcm data, i.e. one side of the wrap point of a ring buffer or a decoded block.
+// size is in bytes and a multiple of the sample size.
+template <class Char>
+struct segment
+{
+    Char*  data = nullptr;
+    size_t size = 0;
+};
+
+namespace detail
+{
+
+template <class Value, class Format, class Char>
+using segment_iterator_t = ::pcm::iterator<Value, Char*, Format>;
+
+// iterates the samples of consecutive segments as if they were one linear range of pcm data.
+// The segments are not owned and must outlive the iterator.
+template <class Value, class Format, class Char>
+class segmented_iterator
+: public boost::iterator_facade<segmented_iterator<Value, Format, Char>,
+                                Value,
+                                std::forward_iterator_tag,
+                                typename segment_iterator_t<Value, Format, Char>::reference>
+{
+    using base_t = boost::iterator_facade<segmented_iterator<Value, Format, Char>,
+                                          Value,
+                                          std::forward_iterator_tag,
+                                          typename segment_iterator_t<Value, Format, Char>::reference>;
+
+public:
+    using segment_type    = ::pcm::segment<Char>;
+    using value_type      = typename base_t::value_type;
+    using difference_type = typename base_t::difference_type;
+    using reference       = typename base_t::reference;
+
+    segmented_iterator() = default;
+
+    // the first sample of [first, last), or the end if the segments are empty
+    segmented_iterator( const segment_type* first, const segment_type* last, const Format& fmt )
+    : segmented_iterator( first, last, first != last ? first->data : nullptr, fmt )
+    {
+    }
+
+    // the sample at pos within *current
+    segmented_iterator( const segment_type* current, const segment_type* last, Char* pos, const Format& fmt )
+    : m_segment( current )
+    , m_last( last )
+    , m_pos( pos )
+    , m_format( fmt )
+    {
+        normalize();
+    }
+
+    const Format& format() const
+    {
+        return m_format;
+    }
+
+    // the current segment, last_segment() for the end iterator
+    auto current_segment() const -> const segment_type*
+    {
+        return m_segment;
+    }
+
+    auto last_segment() const -> const segment_type*
+    {
+        return m_last;
+    }
+
+    // the current byte position, nullptr for the end iterator
+    auto pos() const -> Char*
+    {
+        return m_pos;
+    }
+
+    auto bytes_per_sample() const -> size_t
+    {
+        return size_t( m_format.bitwidth() / 8 );
+    }
+
+private:
+    friend class ::boost::iterator_core_access;
+
+    // steps over the end of the current segment and over empty ones
+    void normalize()
+    {
+        while ( m_segment != m_last && m_pos == m_segment->data + m_segment->size )
+        {
+            assert( m_segment->size % bytes_per_sample() == 0 );
+            if ( ++m_segment != m_last )
+                m_pos = m_segment->data;
+        }
+
+        if ( m_segment == m_last )
+            m_pos = nullptr;
+    }
+
+    void increment()
+    {
+        m_pos += bytes_per_sample();
+        normalize();
+    }
+
+    bool equal( const segmented_iterator& other ) const
+    {
+        return m_segment == other.m_segment && m_pos == other.m_pos;
+    }
+
+    reference dereference() const
+    {
+        return *segment_iterator_t<Value, Format, Char>( m_pos, m_format );
+    }
+
+    const segment_type* m_segment = nullptr;
+    const segment_type* m_last    = nullptr;
+    Char*               m_pos     = nullptr;
+    Format              m_format;
+};
+
+} // namespace detail
+
+template <class Value, class Format = ::pcm::format, class Char = const char>
+using segmented_iterator = detail::segmented_iterator<Value, Format, Char>;
+
+template <class Iterator>
+struct is_segmented_iterator : std::false_type
+{
+};
+
+template <class Value, class Format, class Char>
+struct is_segmented_iterator<detail::segmented_iterator<Value, Format, Char>> : std::true_type
+{
+};
+
+// A range of samples spread over a sequence of segments. pcm::copy converts each segment with the
+// block kernels, so ring buffers and block lists need no linear scratch buffer.
+template <class Value, class Format = ::pcm::format, class Char = const char>
+class segmented_range
+{
+public:
+    using segment_type = segment<Char>;
+    using iterator     = segmented_iterator<Value, Format, Char>;
+
+    segmented_range( const segment_type* first, const segment_type* last, const Format& fmt )
+    : m_first( first )
+    , m_last( last )
+    , m_format( fmt )
+    {
+    }
+
+    auto begin() const -> iterator
+    {
+        return {m_first, m_last, m_format};
+    }
+
+    auto end() const -> iterator
+    {
+        return {m_last, m_last, m_format};
+    }
+
+    // number of samples
+    auto size() const -> size_t
+    {
+        size_t bytes = 0;
+        for ( auto it = m_first; it != m_last; ++it )
+            bytes += it->size;
+        return bytes / size_t( m_format.bitwidth() / 8 );
+    }
+
+    bool empty() const
+    {
+        return begin() == end();
+    }
+
+    const Format& format() const
+    {
+        return m_format;
+    }
+
+private:
+    const segment_type* m_first;
+    const segment_type* m_last;
+    Format              m_format;
+};
+
+// segments is a contiguous container of pcm::segment, e.g. std::array<pcm::segment<const char>, 2>
+template <class Value, class Segments, class Format>
+auto make_segmented_range( const Segments& segments, const Format& fmt )
+{
+    using segment_type = std::remove_const_t<std::remove_pointer_t<decltype( segments.data() )>>;
+    using char_type    = std::remove_pointer_t<decltype( segment_type::data )>;
+
+    return segmented_range<Value, Format, char_type>( segments.data(), segments.data() + segments.size(), fmt );
+}
+
+} // namespace pcm
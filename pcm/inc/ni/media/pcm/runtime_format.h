@@ -53,16 +53,22 @@ struct runtime_format
     : m_number( fmt.number() )
     , m_bitwidth( fmt.bitwidth() )
     , m_endian( fmt.endian() )
+    , m_valid_bits( fmt.valid_bits() )
     , m_index( uint8_t( detail::tuple_find<Format, tags>::value ) )
     {
     }
 
     runtime_format( number_type n, bitwidth_type b, endian_type e = native_endian )
+    : runtime_format( n, b, e, b )
+    {
+    }
+
+    runtime_format( number_type n, bitwidth_type b, endian_type e, bitwidth_type v )
     {
         static auto const formats = detail::tuple_to_array<runtime_format>( tags{} );
 
-        auto it = boost::find_if( formats, [n, b, e]( const auto& fmt ) {
-            return fmt.number() == n && fmt.bitwidth() == b && fmt.endian() == e;
+        auto it = boost::find_if( formats, [n, b, e, v]( const auto& fmt ) {
+            return fmt.number() == n && fmt.bitwidth() == b && fmt.endian() == e && fmt.valid_bits() == v;
         } );
 
         if ( it == formats.end() )
@@ -72,43 +78,52 @@ struct runtime_format
     }
 
     runtime_format( number_type n, size_t bits, endian_type e = native_endian )
+    : runtime_format( n, bits, e, bits )
     {
-        auto bw = bitwidth_type{};
+    }
 
-        switch ( bits )
-        {
-            case 8:
-                bw = _8bit;
-                break;
-            case 16:
-                bw = _16bit;
-                break;
-            case 24:
-                bw = _24bit;
-                break;
-            case 32:
-                bw = _32bit;
-                break;
-            case 64:
-                bw = _64bit;
-                break;
-            default:
-                throw std::runtime_error( "Invalid bitwidth: " + std::to_string( bw ) );
+    runtime_format( number_type n, size_t bits, endian_type e, size_t valid_bits )
+    {
+        const auto to_bitwidth = []( size_t bits ) {
+            switch ( bits )
+            {
+                case 8:
+                    return _8bit;
+                case 12:
+                    return _12bit;
+                case 16:
+                    return _16bit;
+                case 20:
+                    return _20bit;
+                case 24:
+                    return _24bit;
+                case 32:
+                    return _32bit;
+                case 64:
+                    return _64bit;
+                default:
+                    throw std::runtime_error( "Invalid bitwidth: " + std::to_string( bits ) );
+            };
         };
 
-        *this = runtime_format( n, bw, e );
+        *this = runtime_format( n, to_bitwidth( bits ), e, to_bitwidth( valid_bits ) );
     }
 
     // TODO c++17: replace with std::string_view
     runtime_format( const std::string& str )
     {
-        std::regex  regex( "([fsu])([0-9]{1,2})(le|be|ne)" );
+        // "s24in32le" denotes 24 valid bits in a 32 bit container
+        std::regex  regex( "([fsuam])([0-9]{1,2})(?:in([0-9]{1,2}))?(le|be|ne)" );
         std::smatch match;
 
-        if ( std::regex_match( str, match, regex ) && ( match.size() == 4 ) )
+        if ( std::regex_match( str, match, regex ) && ( match.size() == 5 ) )
         {
             const auto to_number = []( const auto& str ) {
-                return str == "f" ? floating_point : str == "s" ? signed_integer : unsigned_integer;
+                return str == "f"   ? floating_point
+                       : str == "s" ? signed_integer
+                       : str == "u" ? unsigned_integer
+                       : str == "a" ? alaw
+                                    : ulaw;
             };
 
             const auto to_bitwidth = []( const auto& str ) { return std::stoul( str ); };
@@ -118,9 +133,13 @@ struct runtime_format
             };
 
 
+            const auto valid_bits = to_bitwidth( match[2].str() );
+            const auto bitwidth   = match[3].matched ? to_bitwidth( match[3].str() ) : valid_bits;
+
             *this = runtime_format( to_number( match[1].str() ), //
-                                    to_bitwidth( match[2].str() ),
-                                    to_endian( match[3].str() ) );
+                                    bitwidth,
+                                    to_endian( match[4].str() ),
+                                    valid_bits );
             return;
         }
 
@@ -142,6 +161,11 @@ struct runtime_format
         return m_endian;
     }
 
+    auto valid_bits() const
+    {
+        return m_valid_bits;
+    }
+
     auto index() const
     {
         return m_index;
@@ -151,6 +175,7 @@ private:
     number_type   m_number;
     bitwidth_type m_bitwidth;
     endian_type   m_endian;
+    bitwidth_type m_valid_bits;
     uint8_t       m_index;
 };
 
@@ -166,10 +191,14 @@ inline bool operator!=( const runtime_format& lhs, const runtime_format& rhs )
 
 inline std::ostream& operator<<( std::ostream& stream, const runtime_format& fmt )
 {
-    const auto number   = fmt.number() == floating_point ? "f" : fmt.number() == signed_integer ? "s" : "u";
+    const auto number   = to_string( fmt.number() );
     const auto bitwidth = static_cast<uint32_t>( fmt.bitwidth() );
+    const auto valid    = static_cast<uint32_t>( fmt.valid_bits() );
     const auto endian   = fmt.endian() == big_endian ? "be" : "le";
 
+    if ( valid != bitwidth )
+        return stream << number << valid << "in" << bitwidth << endian;
+
     return stream << number << bitwidth << endian;
 }
 
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/accumulate.h>
+#include <ni/media/pcm/algorithm/find_first_above.h>
+#include <ni/media/pcm/algorithm/min_max.h>
+#include <ni/media/pcm/algorithm/peak.h>
+#include <ni/media/pcm/algorithm/sum_of_squares.h>
+#include <ni/media/pcm/format.h>
+#include <ni/media/pcm/iterator.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+auto make_samples( const pcm::runtime_format& fmt, size_t count )
+{
+    const auto bytes = size_t( fmt.bitwidth() / 8 );
+
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<double>( -0.9, 0.8 );
+    auto data   = std::vector<char>( count * bytes );
+    for ( size_t i = 0; i < count; ++i )
+        pcm::write( data.data() + i * bytes, dist( engine ), fmt );
+    return data;
+}
+
+template <class Value>
+auto read_samples( const std::vector<char>& data, const pcm::runtime_format& fmt )
+{
+    const auto bytes = size_t( fmt.bitwidth() / 8 );
+
+    auto values = std::vector<Value>( data.size() / bytes );
+    for ( size_t i = 0; i < values.size(); ++i )
+        values[i] = pcm::read<Value>( data.data() + i * bytes, fmt );
+    return values;
+}
+
+template <class Value, class Container>
+void expect_analysis_matches_values( const Container& data, const std::vector<Value>& values, const pcm::runtime_format& fmt )
+{
+    const auto beg = pcm::make_iterator<Value>( data.begin(), fmt );
+    const auto end = pcm::make_iterator<Value>( data.end(), fmt );
+
+    const auto expected_min_max = values.empty() ? std::make_pair( Value( 0 ), Value( 0 ) )
+                                                 : std::make_pair( *std::min_element( values.begin(), values.end() ),
+                                                                   *std::max_element( values.begin(), values.end() ) );
+    EXPECT_EQ( expected_min_max, pcm::min_max( beg, end ) );
+
+    auto expected_peak = Value( 0 );
+    for ( auto value : values )
+        expected_peak = std::max( expected_peak, std::abs( value ) );
+    EXPECT_EQ( expected_peak, pcm::peak( beg, end ) );
+
+    double sum = 0, sum_of_squares = 0;
+    for ( auto value : values )
+    {
+        sum += value;
+        sum_of_squares += double( value ) * value;
+    }
+    // the non-contiguous path sums in Value like std::accumulate
+    EXPECT_NEAR( sum + 1, double( pcm::accumulate( beg, end, Value( 1 ) ) ), 1e-3 );
+    EXPECT_NEAR( sum_of_squares, double( pcm::sum_of_squares( beg, end ) ), 1e-3 );
+    EXPECT_NEAR( values.empty() ? 0. : std::sqrt( sum_of_squares / values.size() ), double( pcm::rms( beg, end ) ), 1e-6 );
+
+    for ( auto threshold : {Value( 0.5 ), Value( 0.85 ), Value( 2 )} )
+    {
+        const auto expected = std::find_if( values.begin(), values.end(), [threshold]( Value value ) {
+            return std::abs( value ) > threshold;
+        } );
+        EXPECT_EQ( std::distance( values.begin(), expected ),
+                   std::distance( beg, pcm::find_first_above( beg, end, threshold ) ) )
+            << "threshold " << threshold;
+    }
+}
+
+template <class Value>
+void expect_analysis_matches_values( const pcm::runtime_format& fmt )
+{
+    for ( auto count : {0, 1, 3, 4, 5, 17, 1023, 1024, 1025, 5000} )
+    {
+        const auto data   = make_samples( fmt, size_t( count ) );
+        const auto values = read_samples<Value>( data, fmt );
+
+        expect_analysis_matches_values( data, values, fmt );
+        expect_analysis_matches_values( std::list<char>( data.begin(), data.end() ), values, fmt );
+    }
+}
+
+} // namespace
+
+TEST( pcm_analysis_test, float_from_integer_formats )
+{
+    for ( auto fmt : {"s8le", "u8le", "s16le", "u16be", "s24le", "s24be", "s32le", "s64be"} )
+        expect_analysis_matches_values<float>( pcm::format( fmt ) );
+}
+
+TEST( pcm_analysis_test, float_from_floating_point_formats )
+{
+    for ( auto fmt : {"f32le", "f32be", "f64le"} )
+        expect_analysis_matches_values<float>( pcm::format( fmt ) );
+}
+
+TEST( pcm_analysis_test, double_values )
+{
+    for ( auto fmt : {"s16le", "s24be", "f64le"} )
+        expect_analysis_matches_values<double>( pcm::format( fmt ) );
+}
+
+TEST( pcm_analysis_test, compiletime_format )
+{
+    using s16le = pcm::compiletime_format<pcm::signed_integer, pcm::_16bit, pcm::little_endian>;
+
+    const auto data = std::vector<int16_t>{0, -16384, 8192, 32767, -32768, 4096};
+    const auto beg  = pcm::make_iterator<float>( reinterpret_cast<const char*>( data.data() ), s16le{} );
+    const auto end  = pcm::make_iterator<float>( reinterpret_cast<const char*>( data.data() + data.size() ), s16le{} );
+
+    EXPECT_EQ( std::make_pair( -1.f, 32767 / 32768.f ), pcm::min_max( beg, end ) );
+    EXPECT_EQ( 1.f, pcm::peak( beg, end ) );
+    EXPECT_EQ( 3, std::distance( beg, pcm::find_first_above( beg, end, 0.5f ) ) );
+    EXPECT_EQ( end, pcm::find_first_above( beg, end, 1.f ) );
+}
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/convert.h>
+#include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/iterator.h>
+#include <ni/media/pcm/numspace.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/range/algorithm/copy.hpp>
+
+#include <vector>
+
+namespace
+{
+
+auto bytes_per_sample( const pcm::runtime_format& fmt )
+{
+    return size_t( fmt.bitwidth() / 8 );
+}
+
+template <class Value>
+auto test_values()
+{
+    auto values = std::vector<Value>{};
+    boost::copy( pcm::numspace<Value>( 12 ), std::back_inserter( values ) );
+    return values;
+}
+
+template <class Value>
+void expect_convert_matches_iterator_copy( const pcm::runtime_format& fmt )
+{
+    const auto values = test_values<Value>();
+    const auto bytes  = values.size() * bytes_per_sample( fmt );
+
+    auto expected_pcm = std::vector<char>( bytes );
+    pcm::copy( values.begin(), values.end(), pcm::make_iterator<Value>( expected_pcm.begin(), fmt ) );
+
+    auto actual_pcm = std::vector<char>( bytes );
+    pcm::convert( values.data(), values.size(), fmt, actual_pcm.data() );
+    EXPECT_EQ( expected_pcm, actual_pcm );
+
+    auto expected_values = std::vector<Value>( values.size() );
+    pcm::copy( pcm::make_iterator<Value>( expected_pcm.cbegin(), fmt ),
+               pcm::make_iterator<Value>( expected_pcm.cend(), fmt ),
+               expected_values.begin() );
+
+    auto actual_values = std::vector<Value>( values.size() );
+    pcm::convert( actual_pcm.data(), values.size(), fmt, actual_values.data() );
+    EXPECT_EQ( expected_values, actual_values );
+}
+
+} // namespace
+
+TEST( pcm_block_convert_test, float_matches_iterator_copy_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_convert_matches_iterator_copy<float>( fmt );
+}
+
+TEST( pcm_block_convert_test, int16_matches_iterator_copy_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_convert_matches_iterator_copy<int16_t>( fmt );
+}
+
+TEST( pcm_block_convert_test, kernel_resolved_from_runtime_format_equals_compiletime_kernel )
+{
+    using s24le = pcm::compiletime_format<pcm::signed_integer, pcm::_24bit, pcm::little_endian>;
+
+    EXPECT_EQ( pcm::read_kernel<float>( pcm::runtime_format( s24le{} ) ), pcm::read_kernel<float>( s24le{} ) );
+    EXPECT_EQ( pcm::write_kernel<float>( pcm::runtime_format( s24le{} ) ), pcm::write_kernel<float>( s24le{} ) );
+}
+
+TEST( pcm_block_convert_test, cached_kernel_converts_consecutive_blocks )
+{
+    const auto fmt    = pcm::format( "s16le" );
+    const auto values = test_values<float>();
+
+    auto data = std::vector<char>( values.size() * bytes_per_sample( fmt ) );
+    pcm::convert( values.data(), values.size(), fmt, data.data() );
+
+    const auto kernel = pcm::read_kernel<float>( fmt );
+    const auto block  = size_t( 100 );
+
+    auto actual = std::vector<float>( values.size() );
+    for ( size_t pos = 0; pos < values.size(); pos += block )
+    {
+        const auto n = std::min( block, values.size() - pos );
+        kernel( data.data() + pos * bytes_per_sample( fmt ), n, actual.data() + pos );
+    }
+
+    EXPECT_EQ( values, actual );
+}
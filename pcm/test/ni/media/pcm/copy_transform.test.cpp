@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/copy_transform.h>
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/format.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <class Value>
+auto make_matrix( size_t in_channels, size_t out_channels )
+{
+    auto engine = std::mt19937{7};
+    auto dist   = std::uniform_real_distribution<Value>( Value( -1 ), Value( 1 ) );
+    auto matrix = std::vector<Value>( in_channels * out_channels );
+    for ( auto& gain : matrix )
+        gain = dist( engine );
+    return matrix;
+}
+
+template <class Value>
+void expect_copy_transform_matches_sample_wise_mix( const pcm::runtime_format& fmt,
+                                                    size_t                     frames,
+                                                    size_t                     in_channels,
+                                                    size_t                     out_channels )
+{
+    const auto bytes  = size_t( fmt.bitwidth() / 8 );
+    const auto matrix = make_matrix<Value>( in_channels, out_channels );
+
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<double>( -1, 1 );
+    auto src    = std::vector<char>( frames * in_channels * bytes );
+    for ( size_t i = 0; i < frames * in_channels; ++i )
+        pcm::write( src.data() + i * bytes, dist( engine ), fmt );
+
+    // one sentinel frame behind the data
+    auto dst = std::vector<Value>( ( frames + 1 ) * out_channels, Value( 42 ) );
+    pcm::copy_transform( src.data(), fmt, dst.data(), frames, in_channels, out_channels, matrix.data() );
+
+    for ( size_t f = 0; f < frames; ++f )
+    {
+        for ( size_t o = 0; o < out_channels; ++o )
+        {
+            Value expected = 0;
+            for ( size_t i = 0; i < in_channels; ++i )
+                expected += matrix[o * in_channels + i]
+                            * pcm::read<Value>( src.data() + ( f * in_channels + i ) * bytes, fmt );
+
+            ASSERT_NEAR( expected, dst[f * out_channels + o], 1e-5 ) << "frame " << f << ", channel " << o;
+        }
+    }
+
+    for ( size_t o = 0; o < out_channels; ++o )
+        EXPECT_EQ( Value( 42 ), dst[frames * out_channels + o] ) << "channel " << o;
+}
+
+template <class Value>
+void expect_copy_transform_matches_sample_wise_mix( size_t in_channels, size_t out_channels )
+{
+    for ( auto fmt : {pcm::format( "s16le" ), pcm::format( "s24be" ), pcm::format( "f32le" )} )
+        for ( auto frames : {0, 1, 3, 4, 5, 17, 1000, 3000} )
+            expect_copy_transform_matches_sample_wise_mix<Value>( fmt, size_t( frames ), in_channels, out_channels );
+}
+
+} // namespace
+
+TEST( pcm_copy_transform_test, mono_to_stereo )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( 1, 2 );
+    expect_copy_transform_matches_sample_wise_mix<double>( 1, 2 );
+}
+
+TEST( pcm_copy_transform_test, stereo_to_mono )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( 2, 1 );
+    expect_copy_transform_matches_sample_wise_mix<double>( 2, 1 );
+}
+
+TEST( pcm_copy_transform_test, stereo_to_stereo )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( 2, 2 );
+}
+
+TEST( pcm_copy_transform_test, surround_to_stereo )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( 6, 2 );
+    expect_copy_transform_matches_sample_wise_mix<double>( 6, 2 );
+}
+
+TEST( pcm_copy_transform_test, arbitrary_matrix )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( 3, 5 );
+    expect_copy_transform_matches_sample_wise_mix<float>( 8, 1 );
+}
+
+TEST( pcm_copy_transform_test, more_channels_than_a_block )
+{
+    expect_copy_transform_matches_sample_wise_mix<float>( pcm::format( "s16le" ), 5, 1100, 2 );
+}
+
+TEST( pcm_copy_transform_test, per_channel_gain )
+{
+    const auto src   = std::vector<int16_t>{16384, -16384, 8192, -8192};
+    const auto gains = std::vector<float>{0.5f, 2.f};
+
+    auto dst = std::vector<float>( 4 );
+    pcm::copy_transform( reinterpret_cast<const char*>( src.data() ),
+                         pcm::format( "s16ne" ),
+                         dst.data(),
+                         2,
+                         2,
+                         gains.data() );
+
+    EXPECT_EQ( ( std::vector<float>{0.25f, -1.f, 0.125f, -0.5f} ), dst );
+}
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/deinterleave_copy.h>
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/format.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <class Value>
+void expect_deinterleave_matches_sample_wise_read( const pcm::runtime_format& fmt, size_t frames, size_t channels )
+{
+    const auto bytes = size_t( fmt.bitwidth() / 8 );
+
+    auto engine = std::mt19937{42};
+    auto src    = std::vector<char>( frames * channels * bytes );
+    for ( auto& byte : src )
+        byte = static_cast<char>( engine() );
+
+    // one sentinel value behind each channel
+    auto planar = std::vector<std::vector<Value>>( channels, std::vector<Value>( frames + 1, Value( 42 ) ) );
+    auto dst    = std::vector<Value*>{};
+    for ( auto& channel : planar )
+        dst.push_back( channel.data() );
+
+    pcm::deinterleave_copy( src.data(), frames, channels, fmt, dst.data() );
+
+    for ( size_t c = 0; c < channels; ++c )
+    {
+        for ( size_t f = 0; f < frames; ++f )
+        {
+            const auto expected = pcm::read<Value>( src.data() + ( f * channels + c ) * bytes, fmt );
+            ASSERT_EQ( expected, planar[c][f] ) << "channel " << c << ", frame " << f;
+        }
+        EXPECT_EQ( Value( 42 ), planar[c][frames] ) << "channel " << c;
+    }
+}
+
+template <class Value>
+void expect_deinterleave_matches_sample_wise_read( const pcm::runtime_format& fmt )
+{
+    for ( auto channels : {1, 2, 3, 4, 5, 6, 7, 8, 12} )
+        for ( auto frames : {0, 1, 3, 4, 5, 17, 1000} )
+            expect_deinterleave_matches_sample_wise_read<Value>( fmt, size_t( frames ), size_t( channels ) );
+}
+
+} // namespace
+
+TEST( pcm_deinterleave_copy_test, float_from_integer_formats )
+{
+    expect_deinterleave_matches_sample_wise_read<float>( pcm::format( "s16le" ) );
+    expect_deinterleave_matches_sample_wise_read<float>( pcm::format( "s24le" ) );
+    expect_deinterleave_matches_sample_wise_read<float>( pcm::format( "u8le" ) );
+    expect_deinterleave_matches_sample_wise_read<float>( pcm::format( "s32be" ) );
+}
+
+TEST( pcm_deinterleave_copy_test, float_from_float_formats )
+{
+    // random bytes may form nans, which never compare equal
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<float>( -1.f, 1.f );
+
+    const size_t frames = 333, channels = 6;
+
+    auto src = std::vector<float>( frames * channels );
+    for ( auto& value : src )
+        value = dist( engine );
+
+    auto planar = std::vector<std::vector<float>>( channels, std::vector<float>( frames ) );
+    auto dst    = std::vector<float*>{};
+    for ( auto& channel : planar )
+        dst.push_back( channel.data() );
+
+    const auto fmt = pcm::make_format<pcm::floating_point, pcm::_32bit>();
+    pcm::deinterleave_copy( reinterpret_cast<const char*>( src.data() ), frames, channels, fmt, dst.data() );
+
+    for ( size_t c = 0; c < channels; ++c )
+        for ( size_t f = 0; f < frames; ++f )
+            ASSERT_EQ( src[f * channels + c], planar[c][f] );
+}
+
+TEST( pcm_deinterleave_copy_test, double_from_integer_formats )
+{
+    expect_deinterleave_matches_sample_wise_read<double>( pcm::format( "s16le" ) );
+    expect_deinterleave_matches_sample_wise_read<double>( pcm::format( "s24be" ) );
+}
+
+TEST( pcm_deinterleave_copy_test, more_channels_than_block_size )
+{
+    expect_deinterleave_matches_sample_wise_read<float>( pcm::format( "s16le" ), 3, 1500 );
+}
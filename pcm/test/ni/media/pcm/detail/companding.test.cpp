@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#include <ni/media/pcm/detail/companding.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace
+{
+
+using alaw_t = pcm::detail::number_t<pcm::alaw>;
+using ulaw_t = pcm::detail::number_t<pcm::ulaw>;
+
+} // namespace
+
+
+TEST( pcm_companding_test, alaw_decode )
+{
+    using pcm::detail::g711::decode;
+
+    EXPECT_EQ( 8, decode( 0xd5, alaw_t{} ) );
+    EXPECT_EQ( -8, decode( 0x55, alaw_t{} ) );
+    EXPECT_EQ( 32256, decode( 0xaa, alaw_t{} ) );
+    EXPECT_EQ( -32256, decode( 0x2a, alaw_t{} ) );
+}
+
+TEST( pcm_companding_test, ulaw_decode )
+{
+    using pcm::detail::g711::decode;
+
+    EXPECT_EQ( 0, decode( 0xff, ulaw_t{} ) );
+    EXPECT_EQ( 0, decode( 0x7f, ulaw_t{} ) );
+    EXPECT_EQ( 32124, decode( 0x80, ulaw_t{} ) );
+    EXPECT_EQ( -32124, decode( 0x00, ulaw_t{} ) );
+}
+
+TEST( pcm_companding_test, alaw_round_trip )
+{
+    using pcm::detail::g711::decode;
+    using pcm::detail::g711::encode;
+
+    for ( int code = 0; code < 256; ++code )
+        EXPECT_EQ( code, encode( decode( uint8_t( code ), alaw_t{} ), alaw_t{} ) ) << "code " << code;
+}
+
+TEST( pcm_companding_test, ulaw_round_trip )
+{
+    using pcm::detail::g711::decode;
+    using pcm::detail::g711::encode;
+
+    // 0x7f is negative zero, it encodes as positive zero
+    for ( int code = 0; code < 256; ++code )
+        EXPECT_EQ( code == 0x7f ? 0xff : code, encode( decode( uint8_t( code ), ulaw_t{} ), ulaw_t{} ) )
+            << "code " << code;
+}
+
+TEST( pcm_companding_test, encode_saturates )
+{
+    using pcm::detail::g711::encode;
+
+    EXPECT_EQ( 0xaa, encode( int16_t( 32767 ), alaw_t{} ) );
+    EXPECT_EQ( 0x2a, encode( int16_t( -32768 ), alaw_t{} ) );
+    EXPECT_EQ( 0x80, encode( int16_t( 32767 ), ulaw_t{} ) );
+    EXPECT_EQ( 0x00, encode( int16_t( -32768 ), ulaw_t{} ) );
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#include <ni/media/pcm/detail/half.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+TEST( pcm_half_test, decode )
+{
+    using pcm::detail::binary16::decode;
+
+    EXPECT_EQ( 0.f, decode( 0x0000 ) );
+    EXPECT_TRUE( std::signbit( decode( 0x8000 ) ) );
+    EXPECT_EQ( 1.f, decode( 0x3c00 ) );
+    EXPECT_EQ( -2.f, decode( 0xc000 ) );
+    EXPECT_EQ( 65504.f, decode( 0x7bff ) );
+    EXPECT_EQ( std::ldexp( 1.f, -14 ), decode( 0x0400 ) );
+    EXPECT_EQ( std::ldexp( 1.f, -24 ), decode( 0x0001 ) );
+    EXPECT_EQ( std::ldexp( 1023.f, -24 ), decode( 0x03ff ) );
+    EXPECT_EQ( std::numeric_limits<float>::infinity(), decode( 0x7c00 ) );
+    EXPECT_EQ( -std::numeric_limits<float>::infinity(), decode( 0xfc00 ) );
+    EXPECT_TRUE( std::isnan( decode( 0x7c01 ) ) );
+}
+
+TEST( pcm_half_test, encode )
+{
+    using pcm::detail::binary16::encode;
+
+    EXPECT_EQ( 0x0000, encode( 0.f ) );
+    EXPECT_EQ( 0x8000, encode( -0.f ) );
+    EXPECT_EQ( 0x3c00, encode( 1.f ) );
+    EXPECT_EQ( 0xbc00, encode( -1.f ) );
+    EXPECT_EQ( 0x3555, encode( 1.f / 3 ) );
+    EXPECT_EQ( 0x7bff, encode( 65504.f ) );
+    EXPECT_EQ( 0x0001, encode( std::ldexp( 1.f, -24 ) ) );
+    EXPECT_EQ( 0x0000, encode( std::ldexp( 1.f, -26 ) ) );
+    EXPECT_EQ( 0x7c00, encode( std::numeric_limits<float>::infinity() ) );
+    EXPECT_EQ( 0xfc00, encode( -1e10f ) );
+}
+
+TEST( pcm_half_test, encode_rounds_to_nearest_even )
+{
+    using pcm::detail::binary16::encode;
+
+    // the spacing of halves in [1, 2) is 2^-10
+    EXPECT_EQ( 0x3c00, encode( 1.f + std::ldexp( 1.f, -11 ) ) );
+    EXPECT_EQ( 0x3c02, encode( 1.f + 3 * std::ldexp( 1.f, -11 ) ) );
+    EXPECT_EQ( 0x3c01, encode( 1.f + std::ldexp( 1.f, -11 ) + std::ldexp( 1.f, -20 ) ) );
+
+    // ties at the top of the range round up to infinity
+    EXPECT_EQ( 0x7bff, encode( 65519.f ) );
+    EXPECT_EQ( 0x7c00, encode( 65520.f ) );
+
+    // subnormal ties
+    EXPECT_EQ( 0x0000, encode( std::ldexp( 1.f, -25 ) ) );
+    EXPECT_EQ( 0x0002, encode( std::ldexp( 3.f, -25 ) ) );
+}
+
+TEST( pcm_half_test, nan_keeps_payload )
+{
+    using pcm::detail::binary16::decode;
+    using pcm::detail::binary16::encode;
+
+    EXPECT_EQ( 0x7e00, encode( std::numeric_limits<float>::quiet_NaN() ) );
+    EXPECT_EQ( 0xfe01, encode( decode( 0xfc01 ) ) );
+    EXPECT_EQ( 0x7fff, encode( decode( 0x7fff ) ) );
+}
+
+TEST( pcm_half_test, round_trip )
+{
+    using pcm::detail::binary16::decode;
+    using pcm::detail::binary16::encode;
+
+    for ( uint32_t half = 0; half < 0x10000; ++half )
+    {
+        // NaNs come back quieted
+        const auto is_nan = ( half & 0x7c00 ) == 0x7c00 && ( half & 0x3ff ) != 0;
+        EXPECT_EQ( is_nan ? half | 0x200 : half, encode( decode( uint16_t( half ) ) ) ) << "half " << half;
+    }
+}
@@ -0,0 +1,494 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/detail/kernels.h>
+#include <ni/media/pcm/format.h>
+#include <ni/media/pcm/numspace.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/range/algorithm/copy.hpp>
+
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+auto available_simd_levels()
+{
+    using pcm::detail::simd_level;
+
+    const auto supported = pcm::detail::supported_simd_level();
+
+    auto levels = std::vector<simd_level>{simd_level::none};
+    if ( supported == simd_level::neon )
+        levels.push_back( simd_level::neon );
+    else
+        for ( auto level : {simd_level::sse2, simd_level::avx2, simd_level::avx512} )
+            if ( level <= supported )
+                levels.push_back( level );
+
+    return levels;
+}
+
+// covers empty ranges, the scalar tails and several vector blocks
+auto sample_counts()
+{
+    return std::vector<size_t>{0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 18, 31, 33, 64, 1031};
+}
+
+template <class Value>
+auto test_values( size_t count, std::true_type /*is_floating_point*/ )
+{
+    auto values = boost::copy_range<std::vector<Value>>( pcm::numspace<Value>( 10 ) );
+    values.insert( values.end(), {Value( -1.5 ), Value( -1 ), Value( -0.0 ), Value( 0 ), Value( 1 ), Value( 1.5 )} );
+    values.resize( count, Value( 0.25 ) );
+    return values;
+}
+
+template <class Value>
+auto test_values( size_t count, std::false_type /*is_floating_point*/ )
+{
+    auto values = boost::copy_range<std::vector<Value>>( pcm::numspace<Value>( 10 ) );
+    values.resize( count, Value( 1 ) );
+    return values;
+}
+
+} // namespace
+
+
+template <class Value, class Format>
+struct vf
+{
+    using value_t  = Value;
+    using format_t = Format;
+};
+
+
+template <class Traits>
+class pcm_kernel_test : public testing::Test
+{
+protected:
+    using Value  = typename Traits::value_t;
+    using Format = typename Traits::format_t;
+
+    static constexpr size_t step = Format{}.bitwidth() / 8;
+    static constexpr size_t size = 1031;
+};
+
+
+TYPED_TEST_SUITE_P( pcm_kernel_test );
+
+TYPED_TEST_P( pcm_kernel_test, read_matches_sample_wise_conversion )
+{
+    using Value  = typename TestFixture::Value;
+    using Format = typename TestFixture::Format;
+
+    auto engine = std::mt19937{42};
+    auto bytes  = std::vector<char>( TestFixture::size * TestFixture::step );
+    for ( auto& byte : bytes )
+        byte = char( engine() );
+
+    auto expected = std::vector<Value>( TestFixture::size );
+    for ( size_t i = 0; i < expected.size(); ++i )
+        expected[i] = pcm::read<Value>( bytes.data() + i * TestFixture::step, Format{} );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto kernel = pcm::detail::select_read_kernel<Value, Format>( level );
+        for ( auto count : sample_counts() )
+        {
+            auto actual = std::vector<Value>( count + 1, Value( 42 ) );
+            kernel( bytes.data(), count, actual.data() );
+
+            EXPECT_EQ( 0, std::memcmp( expected.data(), actual.data(), count * sizeof( Value ) ) )
+                << "simd level " << int( level ) << ", " << count << " samples";
+            EXPECT_EQ( Value( 42 ), actual.back() ) << "simd level " << int( level ) << ", " << count << " samples";
+        }
+    }
+}
+
+TYPED_TEST_P( pcm_kernel_test, write_matches_sample_wise_conversion )
+{
+    using Value  = typename TestFixture::Value;
+    using Format = typename TestFixture::Format;
+
+    const auto values = test_values<Value>( TestFixture::size, std::is_floating_point<Value>{} );
+
+    auto expected = std::vector<char>( values.size() * TestFixture::step );
+    for ( size_t i = 0; i < values.size(); ++i )
+        pcm::write( expected.data() + i * TestFixture::step, values[i], Format{} );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto kernel = pcm::detail::select_write_kernel<Value, Format>( level );
+        for ( auto count : sample_counts() )
+        {
+            auto actual = std::vector<char>( ( count + 1 ) * TestFixture::step, char( 42 ) );
+            kernel( values.data(), count, actual.data() );
+
+            EXPECT_EQ( 0, std::memcmp( expected.data(), actual.data(), count * TestFixture::step ) )
+                << "simd level " << int( level ) << ", " << count << " samples";
+            EXPECT_TRUE( std::all_of( actual.end() - TestFixture::step, actual.end(), []( char c ) { return c == 42; } ) )
+                << "simd level " << int( level ) << ", " << count << " samples";
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P( pcm_kernel_test,
+                             read_matches_sample_wise_conversion,
+                             write_matches_sample_wise_conversion );
+
+
+template <class Value, class Formats>
+struct make_kernel_test
+{
+};
+
+template <class Value, class... Formats>
+struct make_kernel_test<Value, std::tuple<Formats...>>
+{
+    using type = testing::Types<vf<Value, Formats>...>;
+};
+
+template <class Value>
+using make_kernel_test_t = typename make_kernel_test<Value, pcm::format::tags>::type;
+
+INSTANTIATE_TYPED_TEST_SUITE_P( Float, pcm_kernel_test, make_kernel_test_t<float> );
+INSTANTIATE_TYPED_TEST_SUITE_P( Double, pcm_kernel_test, make_kernel_test_t<double> );
+INSTANTIATE_TYPED_TEST_SUITE_P( Int16, pcm_kernel_test, make_kernel_test_t<int16_t> );
+INSTANTIATE_TYPED_TEST_SUITE_P( Int32, pcm_kernel_test, make_kernel_test_t<int32_t> );
+
+
+template <class Source, class Target>
+void expect_byteswap_matches_scalar_kernel()
+{
+    constexpr size_t step = Source{}.bitwidth() / 8;
+
+    auto engine = std::mt19937{42};
+    auto bytes  = std::vector<char>( 1031 * step );
+    for ( auto& byte : bytes )
+        byte = char( engine() );
+
+    auto expected = std::vector<char>( bytes.size() );
+    pcm::detail::scalar::byteswap<Source, Target>( bytes.data(), 1031, expected.data() );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto kernel = pcm::detail::select_byteswap_kernel<Source, Target>( level );
+        for ( auto count : sample_counts() )
+        {
+            auto actual = std::vector<char>( ( count + 1 ) * step, char( 42 ) );
+            kernel( bytes.data(), count, actual.data() );
+
+            EXPECT_EQ( 0, std::memcmp( expected.data(), actual.data(), count * step ) )
+                << "simd level " << int( level ) << ", " << count << " samples";
+            EXPECT_TRUE( std::all_of( actual.end() - step, actual.end(), []( char c ) { return c == 42; } ) )
+                << "simd level " << int( level ) << ", " << count << " samples";
+        }
+    }
+}
+
+template <pcm::number_type n, pcm::bitwidth_type b>
+void expect_byteswaps_match_scalar_kernel()
+{
+    using le = pcm::compiletime_format<n, b, pcm::little_endian>;
+    using be = pcm::compiletime_format<n, b, pcm::big_endian>;
+
+    expect_byteswap_matches_scalar_kernel<le, be>();
+    expect_byteswap_matches_scalar_kernel<be, le>();
+}
+
+TEST( pcm_byteswap_kernel_test, matches_scalar_kernel )
+{
+    expect_byteswaps_match_scalar_kernel<pcm::signed_integer, pcm::_16bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::unsigned_integer, pcm::_16bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::signed_integer, pcm::_24bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::unsigned_integer, pcm::_24bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::signed_integer, pcm::_32bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::signed_integer, pcm::_64bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::floating_point, pcm::_16bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::floating_point, pcm::_32bit>();
+    expect_byteswaps_match_scalar_kernel<pcm::floating_point, pcm::_64bit>();
+}
+
+
+template <class Value, class Format>
+void expect_lookup_covers_all_samples()
+{
+    constexpr size_t step  = Format{}.bitwidth() / 8;
+    constexpr size_t count = size_t( 1 ) << Format{}.bitwidth();
+
+    auto bytes = std::vector<char>( count * step );
+    for ( size_t i = 0; i < count; ++i )
+        for ( size_t k = 0; k < step; ++k )
+            bytes[i * step + k] = char( i >> ( 8 * k ) );
+
+    auto actual = std::vector<Value>( count );
+    pcm::detail::lookup::read<Value, Format>( bytes.data(), count, actual.data() );
+
+    for ( size_t i = 0; i < count; ++i )
+        ASSERT_EQ( pcm::read<Value>( bytes.data() + i * step, Format{} ), actual[i] ) << Format{} << ", sample " << i;
+}
+
+TEST( pcm_lookup_kernel_test, matches_sample_wise_conversion_for_all_samples )
+{
+    using namespace pcm;
+
+    expect_lookup_covers_all_samples<float, compiletime_format<signed_integer, _8bit, little_endian>>();
+    expect_lookup_covers_all_samples<double, compiletime_format<unsigned_integer, _8bit, big_endian>>();
+    expect_lookup_covers_all_samples<float, compiletime_format<signed_integer, _16bit, little_endian>>();
+    expect_lookup_covers_all_samples<float, compiletime_format<signed_integer, _16bit, big_endian>>();
+    expect_lookup_covers_all_samples<double, compiletime_format<unsigned_integer, _16bit, little_endian>>();
+    expect_lookup_covers_all_samples<double, compiletime_format<unsigned_integer, _16bit, big_endian>>();
+    expect_lookup_covers_all_samples<float, compiletime_format<alaw, _8bit, little_endian>>();
+    expect_lookup_covers_all_samples<int16_t, compiletime_format<ulaw, _8bit, little_endian>>();
+    expect_lookup_covers_all_samples<float, compiletime_format<signed_integer, _16bit, big_endian, _12bit>>();
+}
+
+
+template <pcm::number_type n, pcm::bitwidth_type b, pcm::endian_type e, pcm::bitwidth_type v>
+void expect_padding_cleared_on_write( pcm::compiletime_format<n, b, e, v> format )
+{
+    constexpr size_t step = b / 8;
+    constexpr auto   mask = ~uint32_t( 0 ) << ( 32 - v );
+
+    const auto values = test_values<float>( 1031, std::true_type{} );
+
+    for ( auto level : available_simd_levels() )
+    {
+        const auto kernel = pcm::detail::select_write_kernel<float, decltype( format )>( level );
+
+        auto bytes = std::vector<char>( values.size() * step );
+        kernel( values.data(), values.size(), bytes.data() );
+
+        // read back as the container, aligned to the upper bits of an int32_t
+        for ( size_t i = 0; i < values.size(); ++i )
+        {
+            const auto sample = pcm::read<int32_t>( bytes.data() + i * step, pcm::compiletime_format<n, b, e>{} );
+            ASSERT_EQ( 0u, uint32_t( sample ) & ~mask )
+                << format << ", simd level " << int( level ) << ", sample " << i;
+        }
+    }
+}
+
+TEST( pcm_padded_kernel_test, write_clears_padding_bits )
+{
+    using namespace pcm;
+
+    expect_padding_cleared_on_write( compiletime_format<signed_integer, _16bit, little_endian, _12bit>{} );
+    expect_padding_cleared_on_write( compiletime_format<signed_integer, _24bit, big_endian, _20bit>{} );
+    expect_padding_cleared_on_write( compiletime_format<signed_integer, _32bit, little_endian, _24bit>{} );
+}
+
+TEST( pcm_padded_kernel_test, read_ignores_padding_bits )
+{
+    using format = pcm::compiletime_format<pcm::signed_integer, pcm::_32bit, pcm::little_endian, pcm::_24bit>;
+
+    // 0x400000 in the upper 24 bits, garbage in the padding byte
+    const char bytes[] = {char( 0xff ), 0x00, 0x00, 0x40};
+
+    EXPECT_EQ( 0.5f, pcm::read<float>( bytes, format{} ) );
+    EXPECT_EQ( 0x40000000, pcm::read<int32_t>( bytes, format{} ) );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto samples = std::vector<char>( 64 * sizeof( bytes ) );
+        for ( size_t i = 0; i < samples.size(); ++i )
+            samples[i] = bytes[i % sizeof( bytes )];
+
+        auto actual = std::vector<float>( 64 );
+        pcm::detail::select_read_kernel<float, format>( level )( samples.data(), actual.size(), actual.data() );
+
+        EXPECT_TRUE( std::all_of( actual.begin(), actual.end(), []( float f ) { return f == 0.5f; } ) )
+            << "simd level " << int( level );
+    }
+}
+
+
+template <class Format>
+void expect_companded_write_covers_all_samples()
+{
+    // every 16 bit sample, the vector kernels have to find the same segment as the reference encoder
+    auto values = std::vector<float>( 1 << 16 );
+    for ( size_t i = 0; i < values.size(); ++i )
+        values[i] = float( int( i ) - 32768 ) / 32768;
+
+    auto expected = std::vector<char>( values.size() );
+    pcm::detail::scalar::write<float, Format>( values.data(), values.size(), expected.data() );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto actual = std::vector<char>( values.size() );
+        pcm::detail::select_write_kernel<float, Format>( level )( values.data(), values.size(), actual.data() );
+
+        EXPECT_EQ( expected, actual ) << Format{} << ", simd level " << int( level );
+    }
+}
+
+template <class Value, class Format>
+void expect_companded_read_covers_all_codes()
+{
+    auto codes = std::vector<char>( 256 );
+    for ( size_t i = 0; i < codes.size(); ++i )
+        codes[i] = char( i );
+
+    auto expected = std::vector<Value>( codes.size() );
+    pcm::detail::scalar::read<Value, Format>( codes.data(), codes.size(), expected.data() );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto actual = std::vector<Value>( codes.size() );
+        pcm::detail::select_read_kernel<Value, Format>( level )( codes.data(), codes.size(), actual.data() );
+
+        EXPECT_EQ( 0, std::memcmp( expected.data(), actual.data(), actual.size() * sizeof( Value ) ) )
+            << Format{} << ", simd level " << int( level );
+    }
+}
+
+TEST( pcm_companded_kernel_test, read_matches_scalar_kernel_for_all_codes )
+{
+    using namespace pcm;
+
+    expect_companded_read_covers_all_codes<float, compiletime_format<alaw, _8bit, little_endian>>();
+    expect_companded_read_covers_all_codes<double, compiletime_format<alaw, _8bit, big_endian>>();
+    expect_companded_read_covers_all_codes<float, compiletime_format<ulaw, _8bit, little_endian>>();
+    expect_companded_read_covers_all_codes<double, compiletime_format<ulaw, _8bit, big_endian>>();
+}
+
+TEST( pcm_companded_kernel_test, write_matches_scalar_kernel_for_all_samples )
+{
+    using namespace pcm;
+
+    expect_companded_write_covers_all_samples<compiletime_format<alaw, _8bit, little_endian>>();
+    expect_companded_write_covers_all_samples<compiletime_format<ulaw, _8bit, big_endian>>();
+}
+
+
+template <class Value, class Format>
+void expect_half_read_covers_all_codes()
+{
+    constexpr size_t count = 1 << 16;
+
+    auto bytes = std::vector<char>( count * 2 );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        bytes[i * 2]     = char( i );
+        bytes[i * 2 + 1] = char( i >> 8 );
+    }
+
+    auto expected = std::vector<Value>( count );
+    pcm::detail::scalar::read<Value, Format>( bytes.data(), count, expected.data() );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto actual = std::vector<Value>( count );
+        pcm::detail::select_read_kernel<Value, Format>( level )( bytes.data(), count, actual.data() );
+
+        EXPECT_EQ( 0, std::memcmp( expected.data(), actual.data(), actual.size() * sizeof( Value ) ) )
+            << Format{} << ", simd level " << int( level );
+    }
+}
+
+template <class Format>
+void expect_half_write_covers_all_roundings()
+{
+    using pcm::detail::binary16::decode;
+    using pcm::detail::binary16::to_bits;
+    using pcm::detail::binary16::to_float;
+
+    // every half, the ties to its successor in magnitude and the floats right below and above them
+    auto values = std::vector<float>{};
+    for ( uint32_t half = 0; half < ( 1 << 16 ); ++half )
+    {
+        const auto tie = to_bits( decode( uint16_t( half ) ) ) + ( half & 0x7c00 ? 0x1000 : 0 );
+        values.insert( values.end(), {to_float( tie - 1 ), to_float( tie ), to_float( tie + 1 )} );
+    }
+
+    auto expected = std::vector<char>( values.size() * 2 );
+    pcm::detail::scalar::write<float, Format>( values.data(), values.size(), expected.data() );
+
+    for ( auto level : available_simd_levels() )
+    {
+        auto actual = std::vector<char>( expected.size() );
+        pcm::detail::select_write_kernel<float, Format>( level )( values.data(), values.size(), actual.data() );
+
+        EXPECT_EQ( expected, actual ) << Format{} << ", simd level " << int( level );
+    }
+}
+
+TEST( pcm_half_kernel_test, read_matches_scalar_kernel_for_all_codes )
+{
+    using namespace pcm;
+
+    expect_half_read_covers_all_codes<float, compiletime_format<floating_point, _16bit, little_endian>>();
+    expect_half_read_covers_all_codes<float, compiletime_format<floating_point, _16bit, big_endian>>();
+    expect_half_read_covers_all_codes<double, compiletime_format<floating_point, _16bit, little_endian>>();
+    expect_half_read_covers_all_codes<double, compiletime_format<floating_point, _16bit, big_endian>>();
+}
+
+TEST( pcm_half_kernel_test, write_matches_scalar_kernel_for_all_roundings )
+{
+    using namespace pcm;
+
+    expect_half_write_covers_all_roundings<compiletime_format<floating_point, _16bit, little_endian>>();
+    expect_half_write_covers_all_roundings<compiletime_format<floating_point, _16bit, big_endian>>();
+}
+
+TEST( pcm_dither_kernel_test, matches_scalar_kernel )
+{
+    const auto lsb = 1.f / 32768;
+
+    auto engine  = std::mt19937{42};
+    auto uniform = std::uniform_real_distribution<float>{-1.1f, 1.1f};
+    auto values  = std::vector<float>( 1031 );
+    for ( auto& value : values )
+        value = uniform( engine );
+    values[5] = std::numeric_limits<float>::quiet_NaN();
+
+    for ( auto level : available_simd_levels() )
+    {
+        const auto kernels = pcm::detail::select_dither_kernels<float>( level );
+        for ( auto count : sample_counts() )
+        {
+            uint32_t expected_state[] = {1, 2, 3, 4};
+            uint32_t actual_state[]   = {1, 2, 3, 4};
+
+            // two calls, the second one continues with the state of the first one
+            auto expected = std::vector<float>( 2 * count );
+            auto actual   = std::vector<float>( 2 * count );
+            for ( size_t offset : {size_t( 0 ), count} )
+            {
+                pcm::detail::scalar::tpdf( values.data(), count, lsb, expected_state, expected.data() + offset );
+                kernels.tpdf( values.data(), count, lsb, actual_state, actual.data() + offset );
+            }
+            EXPECT_EQ( expected, actual ) << "simd level " << int( level ) << ", " << count << " samples";
+
+            pcm::detail::scalar::noise( count, lsb, expected_state, expected.data() );
+            kernels.noise( count, lsb, actual_state, actual.data() );
+            EXPECT_EQ( expected, actual ) << "simd level " << int( level ) << ", " << count << " samples";
+        }
+    }
+}
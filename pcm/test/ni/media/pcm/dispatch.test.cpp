@@ -21,10 +21,15 @@
 //
 
 #include <ni/media/pcm/algorithm.h>
+#include <ni/media/pcm/dispatch.h>
 #include <ni/media/pcm/iterator.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 
 TEST( dispatch_test, dispatch_throws_runtime_error_on_imcompatible_formats )
 {
@@ -37,3 +42,35 @@ TEST( dispatch_test, dispatch_throws_runtime_error_on_imcompatible_formats )
                      out.begin() ) ),
         std::runtime_error );
 }
+
+TEST( dispatch_test, formats_outside_the_dispatched_set_take_the_generic_path )
+{
+    using formats = std::tuple<pcm::compiletime_format<pcm::floating_point, pcm::_32bit, pcm::little_endian>>;
+
+    auto copy = []( auto beg, auto end, auto out ) -> decltype( std::copy( beg, end, out ) ) {
+        return std::copy( beg, end, out );
+    };
+
+    for ( auto fmt : {pcm::format( "f32le" ), pcm::format( "s16be" ), pcm::format( "u8le" )} )
+    {
+        auto values = std::vector<float>{-1.f, -0.5f, 0.f, 0.25f, 0.5f};
+        auto in     = std::vector<char>( values.size() * fmt.bitwidth() / 8 );
+        pcm::copy( values.begin(), values.end(), pcm::make_iterator<float>( in.begin(), fmt ) );
+
+        auto expected = std::vector<float>( values.size() );
+        auto actual   = std::vector<float>( values.size() );
+
+        pcm::dispatch( copy,
+                       pcm::make_iterator<float>( in.cbegin(), fmt ),
+                       pcm::make_iterator<float>( in.cend(), fmt ),
+                       expected.begin() );
+
+        pcm::dispatch_to<formats>( copy,
+                                   pcm::make_iterator<float>( in.cbegin(), fmt ),
+                                   pcm::make_iterator<float>( in.cend(), fmt ),
+                                   actual.begin() );
+
+        EXPECT_EQ( expected, actual ) << fmt;
+        EXPECT_EQ( values, actual ) << fmt;
+    }
+}
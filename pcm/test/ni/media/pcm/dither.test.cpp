@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/dither.h>
+#include <ni/media/pcm/format.h>
+#include <ni/media/pcm/iterator.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+auto make_values( size_t n, float range )
+{
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<float>( -range, range );
+    auto values = std::vector<float>( n );
+    for ( auto& value : values )
+        value = dist( engine );
+    return values;
+}
+
+auto dither_types()
+{
+    return std::vector<pcm::dither_type>{pcm::dither_type::tpdf,
+                                         pcm::dither_type::first_order_shaped,
+                                         pcm::dither_type::second_order_shaped};
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, tpdf_values_are_quantized_and_close_to_the_input )
+{
+    const auto values = make_values( 10007, 0.9f );
+
+    for ( auto format : {"s8le", "s16le", "s24be", "u16le"} )
+    {
+        const auto fmt = pcm::format( format );
+        const auto lsb = 1.f / float( 1u << ( fmt.bitwidth() - 1 ) );
+
+        auto result = std::vector<float>( values.size() );
+        pcm::dither( pcm::dither_type::tpdf ).apply( values.data(), values.size(), fmt, result.data() );
+
+        for ( size_t i = 0; i < values.size(); ++i )
+        {
+            ASSERT_EQ( std::round( result[i] / lsb ), result[i] / lsb ) << format << ", sample " << i;
+            ASSERT_LE( std::abs( result[i] - values[i] ), 1.5f * lsb ) << format << ", sample " << i;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, tpdf_preserves_values_below_one_lsb_on_average )
+{
+    const auto fmt   = pcm::format( "s16le" );
+    const auto lsb   = 1.0 / 32768;
+    const auto value = float( 0.25 * lsb );
+
+    auto values = std::vector<float>( 100000, value );
+    pcm::dither( pcm::dither_type::tpdf ).apply( values.data(), values.size(), fmt, values.data() );
+
+    double sum = 0;
+    for ( auto v : values )
+        sum += v;
+
+    EXPECT_NEAR( value, sum / values.size(), 0.02 * lsb );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// the shaped noise has no dc component: the error of each channel sums up to a difference of the last errors
+TEST( pcm_dither_test, shaped_errors_cancel_out_per_channel )
+{
+    const auto   fmt      = pcm::format( "s16le" );
+    const auto   lsb      = 1.0 / 32768;
+    const size_t channels = 3;
+    const auto   values   = make_values( 3 * 10000, 0.9f );
+
+    for ( auto type : {pcm::dither_type::first_order_shaped, pcm::dither_type::second_order_shaped} )
+    {
+        auto result = std::vector<float>( values.size() );
+        pcm::dither( type, channels ).apply( values.data(), values.size(), fmt, result.data() );
+
+        for ( size_t c = 0; c < channels; ++c )
+        {
+            double error = 0;
+            for ( size_t i = c; i < values.size(); i += channels )
+                error += double( result[i] ) - double( values[i] );
+
+            EXPECT_LE( std::abs( error ), 6 * lsb ) << int( type ) << ", channel " << c;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, shaped_dither_recovers_from_clipping )
+{
+    const auto fmt = pcm::format( "s16le" );
+    const auto lsb = 1.f / 32768;
+
+    for ( auto type : dither_types() )
+    {
+        auto d      = pcm::dither( type );
+        auto values = std::vector<float>( 1000, 2.f );
+        d.apply( values.data(), values.size(), fmt, values.data() );
+        for ( auto value : values )
+            ASSERT_EQ( 1.f - lsb, value ) << int( type );
+
+        values.assign( 1000, 0.f );
+        d.apply( values.data(), values.size(), fmt, values.data() );
+        for ( auto value : values )
+            ASSERT_LE( std::abs( value ), 8 * lsb ) << int( type );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, consecutive_calls_continue_where_the_previous_one_stopped )
+{
+    const auto fmt    = pcm::format( "s24le" );
+    const auto values = make_values( 2 * 1500, 0.9f );
+
+    for ( auto type : dither_types() )
+    {
+        auto expected = std::vector<float>( values.size() );
+        pcm::dither( type, 2, 7 ).apply( values.data(), values.size(), fmt, expected.data() );
+
+        auto d      = pcm::dither( type, 2, 7 );
+        auto actual = std::vector<float>( values.size() );
+        for ( size_t offset = 0, count = 1; offset < values.size(); offset += count, count = count * 3 + 2 )
+        {
+            count = std::min( count, values.size() - offset );
+            d.apply( values.data() + offset, count, fmt, actual.data() + offset );
+        }
+
+        EXPECT_EQ( expected, actual ) << int( type );
+
+        d.reset();
+        d.apply( values.data(), values.size(), fmt, actual.data() );
+        EXPECT_EQ( expected, actual ) << int( type );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, double_values_are_dithered )
+{
+    const auto fmt    = pcm::format( "s16le" );
+    const auto lsb    = 1.0 / 32768;
+    const auto values = make_values( 1003, 0.9f );
+
+    for ( auto type : dither_types() )
+    {
+        auto input  = std::vector<double>( values.begin(), values.end() );
+        auto result = std::vector<double>( values.size() );
+        pcm::dither( type ).apply( input.data(), input.size(), fmt, result.data() );
+
+        for ( size_t i = 0; i < input.size(); ++i )
+        {
+            ASSERT_EQ( std::round( result[i] / lsb ), result[i] / lsb ) << int( type ) << ", sample " << i;
+            ASSERT_LE( std::abs( result[i] - input[i] ), 4.5 * lsb ) << int( type ) << ", sample " << i;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, wide_and_floating_point_formats_are_not_dithered )
+{
+    const auto values = make_values( 101, 0.9f );
+
+    for ( auto format : {"s32le", "u32be", "f32le", "f64le"} )
+    {
+        for ( auto type : dither_types() )
+        {
+            auto result = std::vector<float>( values.size() );
+            pcm::dither( type ).apply( values.data(), values.size(), pcm::format( format ), result.data() );
+            EXPECT_EQ( values, result ) << format << ", " << int( type );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, copy_dithers_values_written_to_pcm )
+{
+    const auto values = make_values( 2 * 1500 + 1, 0.9f );
+
+    for ( auto format : {"s8le", "s16le", "s24le", "u24be", "f32le"} )
+    {
+        const auto fmt   = pcm::format( format );
+        const auto bytes = values.size() * fmt.bitwidth() / 8;
+
+        for ( auto type : dither_types() )
+        {
+            auto dithered = std::vector<float>( values.size() );
+            pcm::dither( type, 2 ).apply( values.data(), values.size(), fmt, dithered.data() );
+
+            auto expected = std::vector<char>( bytes );
+            pcm::copy( dithered, pcm::make_iterator<float>( expected.begin(), fmt ) );
+
+            auto contiguous = std::vector<char>( bytes );
+            auto d          = pcm::dither( type, 2 );
+            pcm::copy( values, pcm::make_iterator<float>( contiguous.begin(), fmt ), d );
+            EXPECT_EQ( expected, contiguous ) << format << ", " << int( type );
+
+            auto list = std::list<char>( bytes );
+            d         = pcm::dither( type, 2 );
+            pcm::copy( std::list<float>( values.begin(), values.end() ), pcm::make_iterator<float>( list.begin(), fmt ), d );
+            EXPECT_TRUE( std::equal( expected.begin(), expected.end(), list.begin() ) ) << format << ", " << int( type );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TEST( pcm_dither_test, copy_reads_pcm_without_dither )
+{
+    const auto fmt    = pcm::format( "s16le" );
+    const auto values = make_values( 100, 0.9f );
+
+    auto bytes = std::vector<char>( values.size() * 2 );
+    pcm::copy( values, pcm::make_iterator<float>( bytes.begin(), fmt ) );
+
+    auto expected = std::vector<float>( values.size() );
+    auto actual   = std::vector<float>( values.size() );
+    auto d        = pcm::dither( pcm::dither_type::tpdf );
+    pcm::copy( pcm::make_iterator<float>( bytes.cbegin(), fmt ), pcm::make_iterator<float>( bytes.cend(), fmt ), expected.begin() );
+    pcm::copy( pcm::make_iterator<float>( bytes.cbegin(), fmt ),
+               pcm::make_iterator<float>( bytes.cend(), fmt ),
+               actual.begin(),
+               d );
+
+    EXPECT_EQ( expected, actual );
+}
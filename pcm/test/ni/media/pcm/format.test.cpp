@@ -24,6 +24,7 @@
 
 #include <ni/media/pcm/format.h>
 
+#include <sstream>
 
 TEST( pcm_format_test, constructor_default )
 {
@@ -32,7 +33,7 @@ TEST( pcm_format_test, constructor_default )
 
 TEST( pcm_format_test, constructor_throws_invalid_format )
 {
-    EXPECT_THROW( pcm::format f( pcm::floating_point, 16, pcm::little_endian ), std::runtime_error );
+    EXPECT_THROW( pcm::format f( pcm::floating_point, 24, pcm::little_endian ), std::runtime_error );
 }
 
 TEST( pcm_format_test, constructor_throws_invalid_bitwidth )
@@ -252,3 +253,93 @@ TEST( pcm_format_test, constructor_f64le )
 
     EXPECT_EQ( fc, fr );
 }
+
+TEST( pcm_format_test, constructor_a8be )
+{
+    auto fc = pcm::make_format<pcm::alaw, pcm::_8bit, pcm::big_endian>();
+    auto fr = pcm::make_format( pcm::alaw, pcm::_8bit, pcm::big_endian );
+
+    EXPECT_EQ( fc, fr );
+}
+
+TEST( pcm_format_test, constructor_a8le )
+{
+    auto fc = pcm::make_format<pcm::alaw, pcm::_8bit, pcm::little_endian>();
+    auto fr = pcm::make_format( pcm::alaw, pcm::_8bit, pcm::little_endian );
+
+    EXPECT_EQ( fc, fr );
+}
+
+TEST( pcm_format_test, constructor_m8be )
+{
+    auto fc = pcm::make_format<pcm::ulaw, pcm::_8bit, pcm::big_endian>();
+    auto fr = pcm::make_format( pcm::ulaw, pcm::_8bit, pcm::big_endian );
+
+    EXPECT_EQ( fc, fr );
+}
+
+TEST( pcm_format_test, constructor_m8le )
+{
+    auto fc = pcm::make_format<pcm::ulaw, pcm::_8bit, pcm::little_endian>();
+    auto fr = pcm::make_format( pcm::ulaw, pcm::_8bit, pcm::little_endian );
+
+    EXPECT_EQ( fc, fr );
+}
+
+TEST( pcm_format_test, companded_format_strings )
+{
+    EXPECT_EQ( pcm::make_format( pcm::alaw, pcm::_8bit, pcm::little_endian ), pcm::format( "a8le" ) );
+    EXPECT_EQ( pcm::make_format( pcm::ulaw, pcm::_8bit, pcm::big_endian ), pcm::format( "m8be" ) );
+    EXPECT_THROW( pcm::format( "a16le" ), std::runtime_error );
+    EXPECT_THROW( pcm::format( pcm::ulaw, 16, pcm::little_endian ), std::runtime_error );
+
+    std::ostringstream stream;
+    stream << pcm::format( "a8le" ) << " " << pcm::make_format<pcm::ulaw, pcm::_8bit, pcm::big_endian>();
+    EXPECT_EQ( "a8le m8be", stream.str() );
+}
+
+TEST( pcm_format_test, half_format_strings )
+{
+    EXPECT_EQ( pcm::make_format( pcm::floating_point, pcm::_16bit, pcm::little_endian ), pcm::format( "f16le" ) );
+    EXPECT_EQ( pcm::make_format( pcm::floating_point, pcm::_16bit, pcm::big_endian ), pcm::format( "f16be" ) );
+    EXPECT_EQ( pcm::_16bit, pcm::format( "f16ne" ).valid_bits() );
+    EXPECT_THROW( pcm::format( "f8le" ), std::runtime_error );
+    EXPECT_THROW( pcm::format( "f24le" ), std::runtime_error );
+
+    std::ostringstream stream;
+    stream << pcm::format( "f16le" ) << " " << pcm::make_format<pcm::floating_point, pcm::_16bit, pcm::big_endian>();
+    EXPECT_EQ( "f16le f16be", stream.str() );
+}
+
+TEST( pcm_format_test, constructor_s24in32le )
+{
+    auto fc = pcm::make_format<pcm::signed_integer, pcm::_32bit, pcm::little_endian, pcm::_24bit>();
+    auto fr = pcm::make_format( pcm::signed_integer, pcm::_32bit, pcm::little_endian, pcm::_24bit );
+
+    EXPECT_EQ( fc, fr );
+    EXPECT_EQ( pcm::_32bit, fr.bitwidth() );
+    EXPECT_EQ( pcm::_24bit, fr.valid_bits() );
+    EXPECT_NE( fr, pcm::make_format( pcm::signed_integer, pcm::_32bit, pcm::little_endian ) );
+}
+
+TEST( pcm_format_test, padded_format_strings )
+{
+    EXPECT_EQ( pcm::make_format( pcm::signed_integer, pcm::_32bit, pcm::little_endian, pcm::_24bit ),
+               pcm::format( "s24in32le" ) );
+    EXPECT_EQ( pcm::make_format( pcm::signed_integer, pcm::_24bit, pcm::big_endian, pcm::_20bit ),
+               pcm::format( "s20in24be" ) );
+    EXPECT_EQ( pcm::make_format( pcm::signed_integer, pcm::_16bit, pcm::native_endian, pcm::_12bit ),
+               pcm::format( "s12in16ne" ) );
+    EXPECT_EQ( pcm::format( pcm::signed_integer, 32, pcm::little_endian, 24 ), pcm::format( "s24in32le" ) );
+    EXPECT_EQ( pcm::_32bit, pcm::format( "s32le" ).valid_bits() );
+
+    EXPECT_THROW( pcm::format( "s24in16le" ), std::runtime_error );
+    EXPECT_THROW( pcm::format( "u24in32le" ), std::runtime_error );
+    EXPECT_THROW( pcm::format( "s24in32" ), std::runtime_error );
+    EXPECT_THROW( pcm::format( "s12le" ), std::runtime_error );
+
+    std::ostringstream stream;
+    stream << pcm::format( "s24in32le" ) << " "
+           << pcm::make_format<pcm::signed_integer, pcm::_16bit, pcm::big_endian, pcm::_12bit>();
+    EXPECT_EQ( "s24in32le s12in16be", stream.str() );
+}
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/interleave_copy.h>
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/format.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <class Value>
+void expect_interleave_matches_sample_wise_write( const pcm::runtime_format& fmt, size_t frames, size_t channels )
+{
+    const auto bytes = size_t( fmt.bitwidth() / 8 );
+
+    // slightly out of range values exercise the clipping
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<double>( -1.1, 1.1 );
+
+    auto planar = std::vector<std::vector<Value>>( channels, std::vector<Value>( frames ) );
+    auto src    = std::vector<const Value*>{};
+    for ( auto& channel : planar )
+    {
+        for ( auto& value : channel )
+            value = Value( dist( engine ) );
+        src.push_back( channel.data() );
+    }
+
+    // sentinel bytes behind the last frame
+    auto actual = std::vector<char>( ( frames * channels + 1 ) * bytes, char( 42 ) );
+    pcm::interleave_copy( src.data(), frames, channels, fmt, actual.data() );
+
+    auto expected = std::vector<char>( actual.size(), char( 42 ) );
+    for ( size_t f = 0; f < frames; ++f )
+        for ( size_t c = 0; c < channels; ++c )
+            pcm::write( expected.data() + ( f * channels + c ) * bytes, planar[c][f], fmt );
+
+    EXPECT_EQ( expected, actual ) << fmt << ", " << frames << " frames, " << channels << " channels";
+}
+
+template <class Value>
+void expect_interleave_matches_sample_wise_write( const pcm::runtime_format& fmt )
+{
+    for ( auto channels : {1, 2, 3, 4, 5, 6, 7, 8, 12} )
+        for ( auto frames : {0, 1, 3, 4, 5, 17, 1000} )
+            expect_interleave_matches_sample_wise_write<Value>( fmt, size_t( frames ), size_t( channels ) );
+}
+
+} // namespace
+
+TEST( pcm_interleave_copy_test, float_to_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_interleave_matches_sample_wise_write<float>( fmt );
+}
+
+TEST( pcm_interleave_copy_test, double_to_integer_formats )
+{
+    expect_interleave_matches_sample_wise_write<double>( pcm::format( "s16le" ) );
+    expect_interleave_matches_sample_wise_write<double>( pcm::format( "s24be" ) );
+}
+
+TEST( pcm_interleave_copy_test, more_channels_than_block_size )
+{
+    expect_interleave_matches_sample_wise_write<float>( pcm::format( "s16le" ), 3, 1500 );
+}
@@ -36,7 +36,9 @@
 
 #include <algorithm>
 #include <list>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -347,5 +349,24 @@ struct make_iterator_test<Value, std::tuple<Formats...>>
     using type = testing::Types<vf<Value, Formats>...>;
 };
 
+// companded and half float formats are lossy and can't round trip the test values
+template <class Format>
+using lossless_format_t = std::conditional_t<Format{}.number() == pcm::alaw || Format{}.number() == pcm::ulaw
+                                                 || pcm::detail::is_half<Format>::value,
+                                             std::tuple<>,
+                                             std::tuple<Format>>;
+
+template <class Formats>
+struct lossless_formats
+{
+};
+
+template <class... Formats>
+struct lossless_formats<std::tuple<Formats...>>
+{
+    using type = decltype( std::tuple_cat( std::declval<lossless_format_t<Formats>>()... ) );
+};
+
 template <class Value>
-using make_iterator_test_t = typename make_iterator_test<Value, pcm::format::tags>::type;
+using make_iterator_test_t =
+    typename make_iterator_test<Value, typename lossless_formats<pcm::format::tags>::type>::type;
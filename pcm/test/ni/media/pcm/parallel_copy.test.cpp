@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/iterator.h>
+#include <ni/media/pcm/numspace.h>
+#include <ni/media/pcm/parallel.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/range/algorithm/copy.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <atomic>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+// a few chunks of 64 samples and a tail, spread over more threads than chunks
+auto small_chunks()
+{
+    return pcm::parallel_policy( 8, 2, 256 );
+}
+
+template <class Value>
+auto test_values( size_t size )
+{
+    const auto numspace = pcm::numspace<Value>( 64 );
+
+    auto values = std::vector<Value>{};
+    while ( values.size() < size )
+        boost::copy( numspace, std::back_inserter( values ) );
+    values.resize( size );
+    return values;
+}
+
+template <class Value>
+void expect_parallel_copy_matches_copy( const pcm::runtime_format& fmt, size_t size )
+{
+    const auto values = test_values<Value>( size );
+    const auto bytes  = values.size() * size_t( fmt.bitwidth() / 8 );
+
+    auto expected_pcm = std::vector<char>( bytes );
+    pcm::copy( values.begin(), values.end(), pcm::make_iterator<Value>( expected_pcm.begin(), fmt ) );
+
+    auto actual_pcm = std::vector<char>( bytes );
+    auto pcm_end    = pcm::copy(
+        small_chunks(), values.begin(), values.end(), pcm::make_iterator<Value>( actual_pcm.begin(), fmt ) );
+    EXPECT_EQ( expected_pcm, actual_pcm ) << fmt;
+    EXPECT_EQ( actual_pcm.end(), pcm_end.base() ) << fmt;
+
+    auto expected_values = std::vector<Value>( values.size() );
+    pcm::copy( pcm::make_iterator<Value>( expected_pcm.cbegin(), fmt ),
+               pcm::make_iterator<Value>( expected_pcm.cend(), fmt ),
+               expected_values.begin() );
+
+    auto actual_values = std::vector<Value>( values.size() );
+    auto values_end    = pcm::copy( small_chunks(),
+                                 pcm::make_iterator<Value>( expected_pcm.cbegin(), fmt ),
+                                 pcm::make_iterator<Value>( expected_pcm.cend(), fmt ),
+                                 actual_values.begin() );
+    EXPECT_EQ( expected_values, actual_values ) << fmt;
+    EXPECT_EQ( actual_values.end(), values_end ) << fmt;
+}
+
+} // namespace
+
+TEST( pcm_parallel_copy_test, chunk_size_is_a_multiple_of_frames_and_blocks )
+{
+    EXPECT_EQ( 64u, pcm::parallel_policy( 4, 1, 1 ).chunk_size( 4 ) );
+    EXPECT_EQ( 64u * 1024, pcm::parallel_policy( 4, 1, 256 * 1024 ).chunk_size( 4 ) );
+    EXPECT_EQ( 192u * 455, pcm::parallel_policy( 4, 6, 256 * 1024 ).chunk_size( 3 ) );
+    EXPECT_EQ( 0u, pcm::parallel_policy( 4, 6 ).chunk_size( 3 ) % 6 );
+}
+
+TEST( pcm_parallel_copy_test, float_matches_copy_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_parallel_copy_matches_copy<float>( fmt, 1000 );
+}
+
+TEST( pcm_parallel_copy_test, int32_matches_copy_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_parallel_copy_matches_copy<int32_t>( fmt, 1000 );
+}
+
+TEST( pcm_parallel_copy_test, ranges_below_two_chunks )
+{
+    const auto fmt = pcm::format( "s24le" );
+    for ( size_t size : {0, 1, 63, 64, 127} )
+        expect_parallel_copy_matches_copy<float>( fmt, size );
+}
+
+TEST( pcm_parallel_copy_test, range_based )
+{
+    const auto fmt    = pcm::format( "s16le" );
+    const auto values = test_values<int16_t>( 1000 );
+
+    auto data = std::vector<char>( values.size() * 2 );
+    pcm::copy( small_chunks(), values, pcm::make_iterator<int16_t>( data.begin(), fmt ) );
+
+    auto actual = std::vector<int16_t>( values.size() );
+    pcm::copy( small_chunks(),
+               boost::make_iterator_range( pcm::make_iterator<int16_t>( data.cbegin(), fmt ),
+                                           pcm::make_iterator<int16_t>( data.cend(), fmt ) ),
+               actual.begin() );
+    EXPECT_EQ( values, actual );
+}
+
+TEST( pcm_parallel_copy_test, non_contiguous_iterators_are_copied_sequentially )
+{
+    const auto fmt    = pcm::format( "s16le" );
+    const auto values = test_values<int16_t>( 1000 );
+
+    auto data = std::list<char>( values.size() * 2 );
+    pcm::copy( small_chunks(), values.begin(), values.end(), pcm::make_iterator<int16_t>( data.begin(), fmt ) );
+
+    auto actual = std::vector<int16_t>( values.size() );
+    pcm::copy( small_chunks(),
+               pcm::make_iterator<int16_t>( data.begin(), fmt ),
+               pcm::make_iterator<int16_t>( data.end(), fmt ),
+               actual.begin() );
+    EXPECT_EQ( values, actual );
+}
+
+TEST( pcm_parallel_copy_test, chunk_exceptions_are_rethrown )
+{
+    std::atomic<size_t> calls{0};
+    EXPECT_THROW( pcm::detail::parallel_for_chunks( small_chunks(),
+                                                    1000,
+                                                    64,
+                                                    [&]( size_t offset, size_t ) {
+                                                        ++calls;
+                                                        if ( offset == 128 )
+                                                            throw std::runtime_error( "chunk failed" );
+                                                    } ),
+                  std::runtime_error );
+    EXPECT_GE( calls, 1u );
+}
+
+TEST( pcm_parallel_copy_test, chunks_cover_the_range_once )
+{
+    auto visits = std::vector<std::atomic<int>>( 1000 );
+    pcm::detail::parallel_for_chunks( small_chunks(), visits.size(), 64, [&]( size_t offset, size_t size ) {
+        for ( auto i = offset; i < offset + size; ++i )
+            ++visits[i];
+    } );
+
+    for ( const auto& visit : visits )
+        EXPECT_EQ( 1, visit );
+}
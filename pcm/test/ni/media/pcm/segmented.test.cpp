@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/copy.h>
+#include <ni/media/pcm/iterator.h>
+#include <ni/media/pcm/numspace.h>
+#include <ni/media/pcm/range/segmented.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/range/algorithm/copy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <vector>
+
+namespace
+{
+
+template <class Value>
+auto test_values()
+{
+    auto values = std::vector<Value>{};
+    boost::copy( pcm::numspace<Value>( 7 ), std::back_inserter( values ) );
+    return values;
+}
+
+template <class Value>
+auto to_pcm( const std::vector<Value>& values, const pcm::runtime_format& fmt )
+{
+    auto data = std::vector<char>( values.size() * size_t( fmt.bitwidth() / 8 ) );
+    pcm::copy( values.begin(), values.end(), pcm::make_iterator<Value>( data.begin(), fmt ) );
+    return data;
+}
+
+// the samples from offset on are stored in front of the ones before it, like in a ring buffer that wrapped
+template <class Char>
+auto wrapped_segments( Char* ring, size_t bytes, size_t offset ) -> std::array<pcm::segment<Char>, 3>
+{
+    return {{{ring + offset, bytes - offset}, {ring + bytes, 0}, {ring, offset}}};
+}
+
+auto rotated( const std::vector<char>& data, size_t offset )
+{
+    auto ring = data;
+    std::rotate( ring.begin(), ring.end() - offset, ring.end() );
+    return ring;
+}
+
+template <class Value>
+void expect_segmented_read_matches_linear( const pcm::runtime_format& fmt )
+{
+    const auto data   = to_pcm( test_values<Value>(), fmt );
+    const auto offset = 37 * size_t( fmt.bitwidth() / 8 );
+    const auto ring   = rotated( data, offset );
+
+    auto expected = std::vector<Value>( test_values<Value>().size() );
+    pcm::copy( pcm::make_iterator<Value>( data.cbegin(), fmt ),
+               pcm::make_iterator<Value>( data.cend(), fmt ),
+               expected.begin() );
+
+    const auto segments = wrapped_segments( ring.data(), ring.size(), offset );
+    const auto range    = pcm::make_segmented_range<Value>( segments, fmt );
+    EXPECT_EQ( expected.size(), range.size() ) << fmt;
+    EXPECT_TRUE( std::equal( expected.begin(), expected.end(), range.begin(), range.end() ) ) << fmt;
+
+    auto actual = std::vector<Value>( expected.size() );
+    EXPECT_EQ( actual.end(), pcm::copy( range, actual.begin() ) ) << fmt;
+    EXPECT_EQ( expected, actual ) << fmt;
+
+    auto actual_list = std::list<Value>( expected.size() );
+    pcm::copy( range, actual_list.begin() );
+    EXPECT_TRUE( std::equal( expected.begin(), expected.end(), actual_list.begin() ) ) << fmt;
+}
+
+template <class Value>
+void expect_segmented_write_matches_linear( const pcm::runtime_format& fmt )
+{
+    const auto values = test_values<Value>();
+    const auto data   = to_pcm( values, fmt );
+    const auto offset = 37 * size_t( fmt.bitwidth() / 8 );
+
+    auto ring     = std::vector<char>( data.size() );
+    auto segments = wrapped_segments( ring.data(), ring.size(), offset );
+    auto range    = pcm::make_segmented_range<Value>( segments, fmt );
+
+    EXPECT_EQ( range.end(), pcm::copy( values.begin(), values.end(), range.begin() ) ) << fmt;
+    EXPECT_EQ( rotated( data, offset ), ring ) << fmt;
+
+    const auto list = std::list<Value>( values.begin(), values.end() );
+    std::fill( ring.begin(), ring.end(), 0 );
+    EXPECT_EQ( range.end(), pcm::copy( list.begin(), list.end(), range.begin() ) ) << fmt;
+    EXPECT_EQ( rotated( data, offset ), ring ) << fmt;
+}
+
+} // namespace
+
+TEST( pcm_segmented_test, float_read_matches_linear_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_segmented_read_matches_linear<float>( fmt );
+}
+
+TEST( pcm_segmented_test, int16_read_matches_linear_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_segmented_read_matches_linear<int16_t>( fmt );
+}
+
+TEST( pcm_segmented_test, float_write_matches_linear_for_all_formats )
+{
+    for ( const auto& fmt : pcm::runtime_formats() )
+        expect_segmented_write_matches_linear<float>( fmt );
+}
+
+TEST( pcm_segmented_test, partial_ranges )
+{
+    const auto fmt    = pcm::format( "s24le" );
+    const auto values = test_values<int32_t>();
+    const auto data   = to_pcm( values, fmt );
+
+    // three segments of 10, 40 and 78 samples
+    const auto segments = std::vector<pcm::segment<const char>>{
+        {data.data(), 30}, {data.data() + 30, 120}, {data.data() + 150, data.size() - 150}};
+    const auto range = pcm::make_segmented_range<int32_t>( segments, fmt );
+
+    for ( size_t first : {0, 5, 10, 30, 60} )
+    {
+        for ( size_t last : {60, 75, 100} )
+        {
+            const auto beg = std::next( range.begin(), first );
+            const auto end = std::next( range.begin(), last );
+
+            auto actual = std::vector<int32_t>( last - first );
+            EXPECT_EQ( actual.end(), pcm::copy( beg, end, actual.begin() ) );
+            EXPECT_TRUE( std::equal( actual.begin(), actual.end(), values.begin() + first ) ) << first << " " << last;
+        }
+    }
+}
+
+TEST( pcm_segmented_test, partial_write_returns_position_within_segment )
+{
+    const auto fmt    = pcm::make_format<pcm::signed_integer, pcm::_16bit, pcm::little_endian>();
+    const auto values = std::vector<float>( 15, 0.5f );
+
+    auto a        = std::vector<char>( 20 );
+    auto b        = std::vector<char>( 20 );
+    auto segments = std::array<pcm::segment<char>, 2>{{{a.data(), a.size()}, {b.data(), b.size()}}};
+    auto range    = pcm::make_segmented_range<float>( segments, fmt );
+
+    auto pos = pcm::copy( values.begin(), values.end(), range.begin() );
+    EXPECT_EQ( &segments[1], pos.current_segment() );
+    EXPECT_EQ( b.data() + 10, pos.pos() );
+    EXPECT_EQ( 15, std::distance( range.begin(), pos ) );
+
+    pos = pcm::copy( values.begin(), values.begin() + 5, pos );
+    EXPECT_EQ( range.end(), pos );
+
+    for ( auto value : range )
+        EXPECT_EQ( 0.5f, value );
+}
+
+TEST( pcm_segmented_test, empty_ranges )
+{
+    const auto fmt      = pcm::format( "f32le" );
+    const auto segments = std::array<pcm::segment<const char>, 2>{};
+    const auto range    = pcm::make_segmented_range<float>( segments, fmt );
+
+    EXPECT_TRUE( range.empty() );
+    EXPECT_EQ( 0u, range.size() );
+
+    auto out = std::vector<float>{};
+    EXPECT_EQ( out.end(), pcm::copy( range, out.begin() ) );
+}
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2017-2019 Native Instruments GmbH, Berlin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <ni/media/pcm/algorithm/transcode.h>
+#include <ni/media/pcm/converter.h>
+#include <ni/media/pcm/format.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using reference_t = void ( * )( const char*, size_t, char* );
+
+// mu-law has two codes for zero, between the byte orders of the same companded format the codes are copied
+template <class Source, class Target>
+using is_code_copy = std::integral_constant<bool,
+                                            Source{}.number() == Target{}.number()
+                                                && pcm::detail::is_companded<Source{}.number()>::value>;
+
+template <class Source, class Target>
+void reference_transcode( const char* src, size_t n, char* dst, std::true_type /*code copy*/ )
+{
+    std::copy( src, src + n, dst );
+}
+
+// sample-wise conversion through intermediate<Format>, like pcm::read and pcm::write
+template <class Source, class Target>
+void reference_transcode( const char* src, size_t n, char* dst, std::false_type /*code copy*/ )
+{
+    using target_storage = typename pcm::detail::storage<Target>::type;
+
+    for ( size_t i = 0; i < n; ++i, src += Source{}.bitwidth() / 8 )
+    {
+        const auto value = pcm::detail::intermediate<Source>( src ).value();
+        auto       data  = pcm::detail::intermediate<Target>{pcm::detail::convert_to<target_storage>( value )};
+        dst              = std::copy( data.begin(), data.end(), dst );
+    }
+}
+
+template <class Source, class Target>
+void reference_transcode( const char* src, size_t n, char* dst )
+{
+    reference_transcode<Source, Target>( src, n, dst, is_code_copy<Source, Target>{} );
+}
+
+template <class Source, class... Ts>
+auto make_references( const std::tuple<Ts...>& ) -> std::array<reference_t, sizeof...( Ts )>
+{
+    return {{&reference_transcode<Source, Ts>...}};
+}
+
+template <class... Ts>
+auto make_reference_table( const std::tuple<Ts...>& tags )
+{
+    return std::array<std::array<reference_t, sizeof...( Ts )>, sizeof...( Ts )>{{make_references<Ts>( tags )...}};
+}
+
+// random bytes for integer formats, finite values with some clipping for floating point formats.
+// padded formats get zero padding bits, the copy and byteswap paths pass them through unchanged.
+auto make_source( const pcm::runtime_format& fmt, size_t n )
+{
+    auto engine = std::mt19937{42};
+    auto data   = std::vector<char>( n * fmt.bitwidth() / 8 );
+
+    if ( fmt.number() == pcm::floating_point )
+    {
+        auto dist = std::uniform_real_distribution<double>( -1.2, 1.2 );
+        for ( size_t i = 0; i < n; ++i )
+            pcm::write( data.data() + i * fmt.bitwidth() / 8, dist( engine ), fmt );
+    }
+    else
+    {
+        for ( auto& byte : data )
+            byte = static_cast<char>( engine() );
+
+        if ( fmt.valid_bits() != fmt.bitwidth() )
+            for ( size_t i = 0; i < n; ++i )
+            {
+                const auto sample = data.data() + i * fmt.bitwidth() / 8;
+                pcm::write( sample, pcm::read<int32_t>( sample, fmt ), fmt );
+            }
+    }
+
+    return data;
+}
+
+} // namespace
+
+TEST( pcm_transcode_test, matches_sample_wise_conversion_for_all_format_pairs )
+{
+    static const auto references = make_reference_table( pcm::compiletime_formats() );
+
+    for ( const auto& src_fmt : pcm::runtime_formats() )
+    {
+        for ( const auto& dst_fmt : pcm::runtime_formats() )
+        {
+            for ( auto n : {0, 1, 3, 4, 5, 8, 17, 257} )
+            {
+                const auto src = make_source( src_fmt, size_t( n ) );
+
+                // one sentinel sample behind the data, one byte offset to get misaligned buffers as well
+                for ( auto offset : {0, 1} )
+                {
+                    auto expected = std::vector<char>( ( n + 1 ) * dst_fmt.bitwidth() / 8 + 1, char( 42 ) );
+                    auto actual   = expected;
+
+                    references[src_fmt.index()][dst_fmt.index()]( src.data(), size_t( n ), expected.data() + offset );
+                    pcm::transcode( src.data(), src_fmt, actual.data() + offset, dst_fmt, size_t( n ) );
+
+                    ASSERT_EQ( expected, actual ) << src_fmt << " -> " << dst_fmt << ", " << n << " samples";
+                }
+            }
+        }
+    }
+}
+
+TEST( pcm_transcode_test, integer_transcoding_is_exact )
+{
+    const auto src = std::vector<char>{0x01, 0x02, 0x03, char( 0x81 ), 0x00, 0x7f};
+
+    // s24le -> s24be is a byte swap per sample
+    auto s24be = std::vector<char>( 6 );
+    pcm::transcode( src.data(), pcm::format( "s24le" ), s24be.data(), pcm::format( "s24be" ), 2 );
+    EXPECT_EQ( ( std::vector<char>{0x03, 0x02, 0x01, 0x7f, 0x00, char( 0x81 )} ), s24be );
+
+    // s24le -> s32le widens with a shift
+    auto s32le = std::vector<char>( 8 );
+    pcm::transcode( src.data(), pcm::format( "s24le" ), s32le.data(), pcm::format( "s32le" ), 2 );
+    EXPECT_EQ( ( std::vector<char>{0x00, 0x01, 0x02, 0x03, 0x00, char( 0x81 ), 0x00, 0x7f} ), s32le );
+
+    // s24le -> u24le flips the sign bit
+    auto u24le = std::vector<char>( 6 );
+    pcm::transcode( src.data(), pcm::format( "s24le" ), u24le.data(), pcm::format( "u24le" ), 2 );
+    EXPECT_EQ( ( std::vector<char>{0x01, 0x02, char( 0x83 ), char( 0x81 ), 0x00, char( 0xff )} ), u24le );
+}
+
+TEST( pcm_transcode_test, kernel_resolved_from_runtime_formats_equals_compiletime_kernel )
+{
+    using s16be = pcm::compiletime_format<pcm::signed_integer, pcm::_16bit, pcm::big_endian>;
+    using s16le = pcm::compiletime_format<pcm::signed_integer, pcm::_16bit, pcm::little_endian>;
+
+    EXPECT_EQ( pcm::transcode_kernel( s16be{}, s16le{} ),
+               pcm::transcode_kernel( pcm::runtime_format( s16be{} ), pcm::runtime_format( s16le{} ) ) );
+}